@@ -697,7 +697,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy the run of plain characters up to the next escape or quote
+                    const char* run = head;
+
+                    while( head<limit && *head!='\\' && *head!='"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -777,11 +785,11 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
     if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
     {
@@ -808,6 +816,77 @@ exit:   // single point of exit, no returns elsewhere please.
 }
 
 
+void DSNLEXER::ReadRawList( std::string* aText )
+{
+    const char* cur      = next;
+    int         depth    = 1;
+    bool        inString = false;
+
+    // rebuild the list from its opening parenthesis, then copy lines until
+    // its closing parenthesis
+    aText->append( "(" );
+    aText->append( start + curOffset, next );
+
+    for(;;)
+    {
+        const char* head = cur;
+
+        while( head<limit && depth )
+        {
+            char cc = *head++;
+
+            if( inString )
+            {
+                if( cc == '\\' && head<limit )
+                    ++head;
+                else if( cc == stringDelimiter )
+                    inString = false;
+            }
+            else if( cc == stringDelimiter )
+                inString = true;
+            else if( cc == '(' )
+                ++depth;
+            else if( cc == ')' )
+                --depth;
+        }
+
+        aText->append( cur, head );
+
+        if( !depth )
+        {
+            cur = head;
+            break;
+        }
+
+        if( readLine() == 0 )
+        {
+            curTok = DSN_EOF;
+            Expecting( DSN_RIGHT );
+        }
+
+        cur = start;
+
+        // quoted strings do not span lines
+        inString = false;
+
+        // skip comment lines, as NextTok() does
+        const char* first = cur;
+
+        while( first<limit && isSpace( *first ) )
+            ++first;
+
+        if( first<limit && *first=='#' )
+            cur = limit;
+    }
+
+    prevTok   = curTok;
+    curTok    = DSN_RIGHT;
+    curText   = ')';
+    curOffset = cur - 1 - start;
+    next      = cur;
+}
+
+
 wxArrayString* DSNLEXER::ReadCommentLines()
 {
     wxArrayString*  ret = 0;
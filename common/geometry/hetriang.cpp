@@ -51,7 +51,7 @@
 using namespace hed;
 
 #ifdef TTL_USE_NODE_ID
-  int NODE::id_count = 0;
+  std::atomic<int> NODE::id_count( 0 );
 #endif
 
 
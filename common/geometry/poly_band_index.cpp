@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <algorithm>
+
+#include <geometry/poly_band_index.h>
+
+// About this many edges per band; each edge is listed in every band its y range crosses
+static const int EDGES_PER_BAND = 4;
+static const int MAX_BAND_COUNT = 4096;
+
+
+POLY_BAND_INDEX::POLY_BAND_INDEX( const SHAPE_LINE_CHAIN& aPath ) :
+    m_bandHeight( 1 )
+{
+    int pointCount = aPath.PointCount();
+
+    m_valid = aPath.IsClosed() && pointCount >= 3;
+
+    if( !m_valid )
+        return;
+
+    m_bbox = aPath.BBox();
+
+    long long height = (long long) m_bbox.GetHeight() + 1;
+    int bandCount = std::min( MAX_BAND_COUNT, std::max( 1, pointCount / EDGES_PER_BAND ) );
+
+    m_bandHeight = std::max<long long>( 1, ( height + bandCount - 1 ) / bandCount );
+    bandCount = ( height + m_bandHeight - 1 ) / m_bandHeight;
+
+    // An edge can only be crossed by the rays of points with ymin <= y < ymax, so
+    // horizontal edges are left out and an edge is listed in the bands of [ymin, ymax - 1]
+    auto bandRange = [&]( int aEdge, int& aFirst, int& aLast ) -> bool
+    {
+        int y0 = aPath.CPoint( aEdge ).y;
+        int y1 = aPath.CPoint( aEdge + 1 ).y;
+
+        if( y0 == y1 )
+            return false;
+
+        aFirst = ( (long long) std::min( y0, y1 ) - m_bbox.GetY() ) / m_bandHeight;
+        aLast = ( (long long) std::max( y0, y1 ) - 1 - m_bbox.GetY() ) / m_bandHeight;
+        return true;
+    };
+
+    m_bandStart.assign( bandCount + 1, 0 );
+
+    for( int i = 0; i < pointCount; i++ )
+    {
+        int first, last;
+
+        if( bandRange( i, first, last ) )
+        {
+            for( int band = first; band <= last; band++ )
+                m_bandStart[band + 1]++;
+        }
+    }
+
+    for( int band = 0; band < bandCount; band++ )
+        m_bandStart[band + 1] += m_bandStart[band];
+
+    m_edges.resize( m_bandStart[bandCount] );
+
+    std::vector<int> fill( m_bandStart.begin(), m_bandStart.end() - 1 );
+
+    for( int i = 0; i < pointCount; i++ )
+    {
+        int first, last;
+
+        if( bandRange( i, first, last ) )
+        {
+            for( int band = first; band <= last; band++ )
+                m_edges[fill[band]++] = i;
+        }
+    }
+}
+
+
+bool POLY_BAND_INDEX::PointInside( const SHAPE_LINE_CHAIN& aPath, const VECTOR2I& aP ) const
+{
+    if( !m_valid || !m_bbox.Contains( aP ) )
+        return false;
+
+    int band = ( (long long) aP.y - m_bbox.GetY() ) / m_bandHeight;
+    bool inside = false;
+
+    // Same crossing test as SHAPE_LINE_CHAIN::PointInside(), on the edges of the band
+    for( int k = m_bandStart[band]; k < m_bandStart[band + 1]; k++ )
+    {
+        int i = m_edges[k];
+        const VECTOR2D p1 = aPath.CPoint( i );
+        const VECTOR2D p2 = aPath.CPoint( i + 1 );
+        const VECTOR2D diff = p2 - p1;
+
+        if( ( ( p1.y > aP.y ) != ( p2.y > aP.y ) ) &&
+                ( aP.x - p1.x < ( diff.x / diff.y ) * ( aP.y - p1.y ) ) )
+            inside = !inside;
+    }
+
+    return inside;
+}
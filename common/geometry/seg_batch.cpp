@@ -0,0 +1,199 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+
+#include <geometry/seg_batch.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define SEG_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined( SEG_BATCH_SSE2 ) && defined( __GNUC__ )
+#define SEG_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+// The kernels read the vertices as pairs of 32 bit integers
+static_assert( sizeof( VECTOR2I ) == 2 * sizeof( int ), "VECTOR2I is expected to be two ints" );
+
+
+/**
+ * The box to check against, grown by the clearance. Kept as doubles, which hold the
+ * 32 bit coordinates and their differences exactly.
+ */
+struct NEAR_BOX
+{
+    double m_minX, m_minY, m_maxX, m_maxY;
+
+    NEAR_BOX( const BOX2I& aBox, int aClearance )
+    {
+        BOX2I box( aBox );
+        box.Normalize();
+
+        m_minX = (double) box.GetX() - aClearance;
+        m_minY = (double) box.GetY() - aClearance;
+        m_maxX = (double) box.GetX() + box.GetWidth() + aClearance;
+        m_maxY = (double) box.GetY() + box.GetHeight() + aClearance;
+    }
+};
+
+
+static int findScalar( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                       const NEAR_BOX& aBox )
+{
+    for( int i = aStart; i < aSegmentCount; i++ )
+    {
+        const VECTOR2I& a = aPoints[i];
+        const VECTOR2I& b = aPoints[i + 1];
+
+        if( std::max( a.x, b.x ) < aBox.m_minX || std::min( a.x, b.x ) > aBox.m_maxX )
+            continue;
+
+        if( std::max( a.y, b.y ) < aBox.m_minY || std::min( a.y, b.y ) > aBox.m_maxY )
+            continue;
+
+        return i;
+    }
+
+    return -1;
+}
+
+
+#ifdef SEG_BATCH_SSE2
+
+static inline __m128d loadPoint( const VECTOR2I* aPoint )
+{
+    return _mm_cvtepi32_pd( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( aPoint ) ) );
+}
+
+
+/**
+ * One segment per step: the x and y of a vertex are the two lanes of a register.
+ */
+static int findSSE2( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                     const NEAR_BOX& aBox )
+{
+    const __m128d boxMin = _mm_set_pd( aBox.m_minY, aBox.m_minX );
+    const __m128d boxMax = _mm_set_pd( aBox.m_maxY, aBox.m_maxX );
+
+    __m128d a = loadPoint( aPoints + aStart );
+
+    for( int i = aStart; i < aSegmentCount; i++ )
+    {
+        __m128d b = loadPoint( aPoints + i + 1 );
+
+        __m128d outside = _mm_or_pd( _mm_cmplt_pd( _mm_max_pd( a, b ), boxMin ),
+                                     _mm_cmpgt_pd( _mm_min_pd( a, b ), boxMax ) );
+
+        if( !_mm_movemask_pd( outside ) )
+            return i;
+
+        a = b;
+    }
+
+    return -1;
+}
+
+#endif
+
+
+#ifdef SEG_BATCH_AVX2
+
+/**
+ * Two segments per step: lanes hold the x and y of vertices i and i + 1, compared with
+ * vertices i + 1 and i + 2.
+ */
+__attribute__(( target( "avx2" ) ))
+static int findAVX2( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                     const NEAR_BOX& aBox )
+{
+    const __m256d boxMin = _mm256_set_pd( aBox.m_minY, aBox.m_minX, aBox.m_minY, aBox.m_minX );
+    const __m256d boxMax = _mm256_set_pd( aBox.m_maxY, aBox.m_maxX, aBox.m_maxY, aBox.m_maxX );
+
+    int i = aStart;
+
+    for( ; i + 2 <= aSegmentCount; i += 2 )
+    {
+        __m256d a = _mm256_cvtepi32_pd(
+                _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + i ) ) );
+        __m256d b = _mm256_cvtepi32_pd(
+                _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + i + 1 ) ) );
+
+        __m256d outside = _mm256_or_pd(
+                _mm256_cmp_pd( _mm256_max_pd( a, b ), boxMin, _CMP_LT_OQ ),
+                _mm256_cmp_pd( _mm256_min_pd( a, b ), boxMax, _CMP_GT_OQ ) );
+
+        int mask = _mm256_movemask_pd( outside );
+
+        if( !( mask & 0x3 ) )
+            return i;
+
+        if( !( mask & 0xc ) )
+            return i + 1;
+    }
+
+    return findSSE2( aPoints, i, aSegmentCount, aBox );
+}
+
+
+static bool cpuHasAVX2()
+{
+    static const bool hasAVX2 = __builtin_cpu_supports( "avx2" );
+
+    return hasAVX2;
+}
+
+#endif
+
+
+int FindSegmentNearBox( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                        const BOX2I& aBox, int aClearance )
+{
+    if( aStart >= aSegmentCount )
+        return -1;
+
+    NEAR_BOX box( aBox, aClearance );
+
+#if defined( SEG_BATCH_AVX2 )
+    if( cpuHasAVX2() )
+        return findAVX2( aPoints, aStart, aSegmentCount, box );
+#endif
+
+#if defined( SEG_BATCH_SSE2 )
+    return findSSE2( aPoints, aStart, aSegmentCount, box );
+#else
+    return findScalar( aPoints, aStart, aSegmentCount, box );
+#endif
+}
+
+
+int FindSegmentNearBoxScalar( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                              const BOX2I& aBox, int aClearance )
+{
+    if( aStart >= aSegmentCount )
+        return -1;
+
+    return findScalar( aPoints, aStart, aSegmentCount, NEAR_BOX( aBox, aClearance ) );
+}
@@ -151,8 +151,10 @@ static inline bool Collide( const SHAPE_CIRCLE& aA, const SHAPE_LINE_CHAIN& aB,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
     bool found = false;
+    const BOX2I circleBox = aA.BBox();
 
-    for( int s = 0; s < aB.SegmentCount(); s++ )
+    for( int s = aB.NextSegmentNear( circleBox, aClearance ); s >= 0;
+         s = aB.NextSegmentNear( circleBox, aClearance, s + 1 ) )
     {
         if( aA.Collide( aB.CSegment( s ), aClearance ) )
         {
@@ -221,9 +223,14 @@ static inline bool Collide( const SHAPE_CIRCLE& aA, const SHAPE_SEGMENT& aSeg, i
 static inline bool Collide( const SHAPE_LINE_CHAIN& aA, const SHAPE_LINE_CHAIN& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
-    for( int i = 0; i < aB.SegmentCount(); i++ )
+    const BOX2I boxA = aA.BBox();
+
+    for( int i = aB.NextSegmentNear( boxA, aClearance ); i >= 0;
+         i = aB.NextSegmentNear( boxA, aClearance, i + 1 ) )
+    {
         if( aA.Collide( aB.CSegment( i ), aClearance ) )
             return true;
+    }
 
     return false;
 }
@@ -246,7 +253,10 @@ static inline bool Collide( const SHAPE_SIMPLE& aA, const SHAPE_SIMPLE& aB, int
 static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_LINE_CHAIN& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
-    for( int s = 0; s < aB.SegmentCount(); s++ )
+    const BOX2I rectBox = aA.BBox();
+
+    for( int s = aB.NextSegmentNear( rectBox, aClearance ); s >= 0;
+         s = aB.NextSegmentNear( rectBox, aClearance, s + 1 ) )
     {
         SEG seg = aB.CSegment( s );
 
@@ -27,6 +27,7 @@
 #include <common.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_circle.h>
+#include <geometry/seg_batch.h>
 
 bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance ) const
 {
@@ -52,7 +53,9 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance ) const
     BOX2I box_a( aSeg.A, aSeg.B - aSeg.A );
     BOX2I::ecoord_type dist_sq = (BOX2I::ecoord_type) aClearance * aClearance;
 
-    for( int i = 0; i < SegmentCount(); i++ )
+    // NextSegmentNear() only skips segments the box distance test below rejects as well
+    for( int i = NextSegmentNear( box_a, aClearance ); i >= 0;
+         i = NextSegmentNear( box_a, aClearance, i + 1 ) )
     {
         const SEG& s = CSegment( i );
         BOX2I box_b( s.A, s.B - s.A );
@@ -70,6 +73,33 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance ) const
 }
 
 
+int SHAPE_LINE_CHAIN::NextSegmentNear( const BOX2I& aBox, int aClearance, int aStart ) const
+{
+    int n = PointCount();
+
+    aStart = std::max( aStart, 0 );
+
+    if( n > 1 && aStart < n - 1 )
+    {
+        int i = FindSegmentNearBox( &m_points[0], aStart, n - 1, aBox, aClearance );
+
+        if( i >= 0 )
+            return i;
+    }
+
+    // the closing segment does not lie in m_points
+    if( m_closed && n > 0 && aStart <= n - 1 )
+    {
+        const VECTOR2I closing[2] = { m_points[n - 1], m_points[0] };
+
+        if( FindSegmentNearBoxScalar( closing, 0, 1, aBox, aClearance ) == 0 )
+            return n - 1;
+    }
+
+    return -1;
+}
+
+
 const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
 {
     SHAPE_LINE_CHAIN a( *this );
@@ -33,9 +33,13 @@
 #include <list>
 #include <algorithm>
 #include <unordered_set>
+#include <exception>
+#include <iterator>
+#include <thread>
 
 #include <common.h>
 #include <md5_hash.h>
+#include <parallel_for.h>
 #include <map>
 
 #include <geometry/geometry_utils.h>
@@ -161,6 +165,7 @@ int SHAPE_POLY_SET::NewOutline()
     empty_path.SetClosed( true );
     poly.push_back( empty_path );
     m_polys.push_back( poly );
+    m_pointIndex.clear();
     return m_polys.size() - 1;
 }
 
@@ -177,6 +182,7 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
 
     // Add hole to the selected outline
     m_polys[aOutline].push_back( empty_path );
+    m_pointIndex.clear();
 
     return m_polys.back().size() - 2;
 }
@@ -198,6 +204,7 @@ int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDu
     assert( idx < (int) m_polys[aOutline].size() );
 
     m_polys[aOutline][idx].Append( x, y, aAllowDuplication );
+    m_pointIndex.clear();
 
     return m_polys[aOutline][idx].PointCount();
 }
@@ -221,6 +228,8 @@ void SHAPE_POLY_SET::InsertVertex( int aGlobalIndex, VECTOR2I aNewVertex )
             m_polys[index.m_polygon][index.m_contour].Insert( index.m_vertex, aNewVertex );
         else
             throw( std::out_of_range( "aGlobalIndex-th vertex does not exist" ) );
+
+        m_pointIndex.clear();
     }
 }
 
@@ -280,6 +289,8 @@ VECTOR2I& SHAPE_POLY_SET::Vertex( int aIndex, int aOutline, int aHole )
     assert( aOutline < (int) m_polys.size() );
     assert( idx < (int) m_polys[aOutline].size() );
 
+    m_pointIndex.clear();
+
     return m_polys[aOutline][idx].Point( aIndex );
 }
 
@@ -311,6 +322,8 @@ VECTOR2I& SHAPE_POLY_SET::Vertex( int aGlobalIndex )
     if( !GetRelativeIndices( aGlobalIndex, &index ) )
         throw( std::out_of_range( "aGlobalIndex-th vertex does not exist" ) );
 
+    m_pointIndex.clear();
+
     return m_polys[index.m_polygon][index.m_contour].Point( index.m_vertex );
 }
 
@@ -434,6 +447,7 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
     poly.push_back( aOutline );
 
     m_polys.push_back( poly );
+    m_pointIndex.clear();
 
     return m_polys.size() - 1;
 }
@@ -451,6 +465,7 @@ int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
     assert( poly.size() );
 
     poly.push_back( aHole );
+    m_pointIndex.clear();
 
     return poly.size() - 1;
 }
@@ -637,6 +652,7 @@ void SHAPE_POLY_SET::Inflate( int aFactor, int aCircleSegmentsCount )
 void SHAPE_POLY_SET::importTree( PolyTree* tree )
 {
     m_polys.clear();
+    m_pointIndex.clear();
 
     for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
     {
@@ -880,6 +896,8 @@ void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
     {
         fractureSingle( paths );
     }
+
+    m_pointIndex.clear();
 }
 
 
@@ -1078,6 +1096,114 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+int SHAPE_POLY_SET::SimplifyParallel( POLYGON_MODE aFastMode )
+{
+    // Below this, the threads cost more than they save
+    const unsigned minPolysPerBucket = 256;
+
+    unsigned bucketCount = std::min<unsigned>( 2 * std::thread::hardware_concurrency(),
+                                               m_polys.size() / minPolysPerBucket );
+
+    if( bucketCount < 2 )
+    {
+        Simplify( aFastMode );
+        return 1;
+    }
+
+    // Clipper sweeps the set along Y, and rounds intersection points to the scanlines of
+    // the whole input. Only groups of polygons which share no Y coordinate are therefore
+    // simplified to exactly the same points on their own: split the set into such bands.
+    struct Y_RANGE
+    {
+        int m_top, m_bottom;
+        unsigned m_index;
+    };
+
+    std::vector<Y_RANGE> ranges;
+    long long totalVertices = 0;
+
+    ranges.reserve( m_polys.size() );
+
+    for( unsigned i = 0; i < m_polys.size(); i++ )
+    {
+        BOX2I bb;
+        int vertices = 0;
+
+        for( const SHAPE_LINE_CHAIN& path : m_polys[i] )
+        {
+            if( path.PointCount() == 0 )
+                continue;
+
+            if( vertices == 0 )
+                bb = path.BBox();
+            else
+                bb.Merge( path.BBox() );
+
+            vertices += path.PointCount();
+        }
+
+        // Empty polygons are dropped by Clipper anyway
+        if( vertices == 0 )
+            continue;
+
+        ranges.push_back( { bb.GetY(), bb.GetBottom(), i } );
+        totalVertices += vertices;
+    }
+
+    if( totalVertices == 0 )
+    {
+        Simplify( aFastMode );
+        return 1;
+    }
+
+    // Clipper sweeps from the bottom, so list the bands in that order: this is also the
+    // order in which it outputs their polygons.
+    std::sort( ranges.begin(), ranges.end(), []( const Y_RANGE& a, const Y_RANGE& b )
+    {
+        return a.m_bottom > b.m_bottom;
+    } );
+
+    // Cut the bands into buckets of about the same number of vertices
+    std::vector<SHAPE_POLY_SET> buckets( 1 );
+    long long vertices = 0;
+    int bandTop = ranges[0].m_top;
+
+    for( const Y_RANGE& range : ranges )
+    {
+        POLYGON& poly = m_polys[range.m_index];
+
+        if( range.m_bottom < bandTop && !buckets.back().m_polys.empty()
+                && vertices * bucketCount >= (long long) buckets.size() * totalVertices )
+        {
+            buckets.emplace_back();
+        }
+
+        bandTop = std::min( bandTop, range.m_top );
+
+        for( const SHAPE_LINE_CHAIN& path : poly )
+            vertices += path.PointCount();
+
+        buckets.back().m_polys.push_back( std::move( poly ) );
+    }
+
+    m_polys.clear();
+    m_pointIndex.clear();
+
+    ParallelFor( buckets.size(), [&buckets, aFastMode]( size_t i )
+    {
+        buckets[i].Simplify( aFastMode );
+    } );
+
+    for( SHAPE_POLY_SET& bucket : buckets )
+    {
+        m_polys.insert( m_polys.end(), std::make_move_iterator( bucket.m_polys.begin() ),
+                        std::make_move_iterator( bucket.m_polys.end() ) );
+    }
+
+    return buckets.size();
+}
+
+
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
     // We are expecting only one main outline, but this main outline can have holes
@@ -1145,6 +1271,8 @@ bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
     if( tmp != "polyset" )
         return false;
 
+    m_pointIndex.clear();
+
     aStream >> tmp;
 
     int n_polys = atoi( tmp.c_str() );
@@ -1279,6 +1407,7 @@ bool SHAPE_POLY_SET::Collide( const VECTOR2I& aP, int aClearance ) const
 void SHAPE_POLY_SET::RemoveAllContours()
 {
     m_polys.clear();
+    m_pointIndex.clear();
 }
 
 
@@ -1289,6 +1418,7 @@ void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
         aPolygonIdx += m_polys.size();
 
     m_polys[aPolygonIdx].erase( m_polys[aPolygonIdx].begin() + aContourIdx );
+    m_pointIndex.clear();
 }
 
 
@@ -1348,12 +1478,14 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 {
     m_polys.erase( m_polys.begin() + aIdx );
+    m_pointIndex.clear();
 }
 
 
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
+    m_pointIndex.clear();
 }
 
 
@@ -1466,24 +1598,25 @@ void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 void SHAPE_POLY_SET::RemoveVertex( VERTEX_INDEX aIndex )
 {
     m_polys[aIndex.m_polygon][aIndex.m_contour].Remove( aIndex.m_vertex );
+    m_pointIndex.clear();
 }
 
 
 bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, bool aIgnoreHoles ) const
 {
     // Check that the point is inside the outline
-    if( pointInPolygon( aP, m_polys[aSubpolyIndex][0] ) )
+    if( pointInContour( aP, aSubpolyIndex, 0 ) )
     {
         if( !aIgnoreHoles )
         {
             // Check that the point is not in any of the holes
             for( int holeIdx = 0; holeIdx < HoleCount( aSubpolyIndex ); holeIdx++ )
             {
-                const SHAPE_LINE_CHAIN hole = CHole( aSubpolyIndex, holeIdx );
+                const SHAPE_LINE_CHAIN& hole = CHole( aSubpolyIndex, holeIdx );
 
                 // If the point is inside a hole (and not on its edge),
                 // it is outside of the polygon
-                if( pointInPolygon( aP, hole ) && !hole.PointOnEdge( aP ) )
+                if( pointInContour( aP, aSubpolyIndex, holeIdx + 1 ) && !hole.PointOnEdge( aP ) )
                     return false;
             }
         }
@@ -1501,6 +1634,34 @@ bool SHAPE_POLY_SET::pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN&
 }
 
 
+bool SHAPE_POLY_SET::pointInContour( const VECTOR2I& aP, int aPolygon, int aContour ) const
+{
+    const SHAPE_LINE_CHAIN& path = m_polys[aPolygon][aContour];
+
+    if( m_pointIndex.empty() )
+        return pointInPolygon( aP, path );
+
+    return m_pointIndex[aPolygon][aContour].PointInside( path, aP );
+}
+
+
+void SHAPE_POLY_SET::CachePointIndex()
+{
+    if( !m_pointIndex.empty() )
+        return;
+
+    m_pointIndex.resize( m_polys.size() );
+
+    for( unsigned i = 0; i < m_polys.size(); i++ )
+    {
+        m_pointIndex[i].reserve( m_polys[i].size() );
+
+        for( const SHAPE_LINE_CHAIN& path : m_polys[i] )
+            m_pointIndex[i].push_back( POLY_BAND_INDEX( path ) );
+    }
+}
+
+
 void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 {
     for( POLYGON& poly : m_polys )
@@ -1510,6 +1671,8 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
             path.Move( aVector );
         }
     }
+
+    m_pointIndex.clear();
 }
 
 
@@ -1522,6 +1685,8 @@ void SHAPE_POLY_SET::Rotate( double aAngle, const VECTOR2I& aCenter )
             path.Rotate( aAngle, aCenter );
         }
     }
+
+    m_pointIndex.clear();
 }
 
 
@@ -1855,10 +2020,10 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
     static_cast<SHAPE&>(*this) = aOther;
     m_polys = aOther.m_polys;
 
-    // reset poly cache:
+    // reset poly cache (the triangulated polygons are kept for CacheTriangulation() to reuse):
     m_hash = MD5_HASH{};
     m_triangulationValid = false;
-    m_triangulatedPolys.clear();
+    m_pointIndex.clear();
     return *this;
 }
 
@@ -2043,7 +2208,7 @@ bool SHAPE_POLY_SET::IsTriangulationUpToDate() const
 }
 
 
-void SHAPE_POLY_SET::CacheTriangulation()
+void SHAPE_POLY_SET::CacheTriangulation( bool aParallel )
 {
     bool recalculate = !m_hash.IsValid();
     MD5_HASH hash;
@@ -2065,24 +2230,97 @@ void SHAPE_POLY_SET::CacheTriangulation()
     if( !recalculate )
         return;
 
+    // Below this, triangulating on several threads costs more than it saves
+    const int minParallelVertices = 5000;
+
     SHAPE_POLY_SET tmpSet = *this;
 
     if( !tmpSet.HasHoles() )
         tmpSet.Unfracture( PM_FAST );
 
-    m_triangulatedPolys.clear();
+    m_triangulationValid = false;
 
     if( tmpSet.HasTouchingHoles() )
     {
         // temporary workaround for overlapping hole vertices that poly2tri doesn't handle
-        m_triangulationValid = false;
+        m_triangulatedPolys.clear();
+        m_triangulatedHashes.clear();
         return;
     }
 
+    // The polygons which did not change since the last triangulation (e.g. the islands of
+    // a zone fill away from the edit) keep their triangles
+    std::map<MD5_HASH, std::unique_ptr<TRIANGULATED_POLYGON>> previous;
+
+    for( unsigned i = 0; i < m_triangulatedPolys.size(); i++ )
+        previous[m_triangulatedHashes[i]] = std::move( m_triangulatedPolys[i] );
+
+    m_triangulatedPolys.clear();
+    m_triangulatedHashes.clear();
+
+    std::vector<int> toTriangulate;
+    int vertexCount = 0;
+
     for( int i = 0; i < tmpSet.OutlineCount(); i++ )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        triangulateSingle( tmpSet.Polygon( i ), *m_triangulatedPolys.back() );
+        MD5_HASH hash = polygonChecksum( tmpSet.m_polys[i] );
+        auto it = previous.find( hash );
+
+        if( it != previous.end() )
+        {
+            m_triangulatedPolys.push_back( std::move( it->second ) );
+            previous.erase( it );
+        }
+        else
+        {
+            m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
+            toTriangulate.push_back( i );
+            vertexCount += totalVertexCount( tmpSet.m_polys[i] );
+        }
+
+        m_triangulatedHashes.push_back( hash );
+    }
+
+    // Largest first, so that the threads finish together
+    std::sort( toTriangulate.begin(), toTriangulate.end(), [&tmpSet]( int a, int b )
+    {
+        return totalVertexCount( tmpSet.m_polys[a] ) > totalVertexCount( tmpSet.m_polys[b] );
+    } );
+
+    std::vector<std::exception_ptr> errors( toTriangulate.size() );
+
+    auto triangulate = [&]( size_t aJob )
+    {
+        int i = toTriangulate[aJob];
+
+        try
+        {
+            triangulateSingle( tmpSet.m_polys[i], *m_triangulatedPolys[i] );
+        }
+        catch( ... )
+        {
+            errors[aJob] = std::current_exception();
+        }
+    };
+
+    if( aParallel && toTriangulate.size() > 1 && vertexCount >= minParallelVertices )
+    {
+        ParallelFor( toTriangulate.size(), triangulate );
+    }
+    else
+    {
+        for( size_t job = 0; job < toTriangulate.size(); job++ )
+            triangulate( job );
+    }
+
+    for( const std::exception_ptr& error : errors )
+    {
+        if( error )
+        {
+            m_triangulatedPolys.clear();
+            m_triangulatedHashes.clear();
+            std::rethrow_exception( error );
+        }
     }
 
     m_triangulationValid = true;
@@ -2090,6 +2328,29 @@ void SHAPE_POLY_SET::CacheTriangulation()
 }
 
 
+MD5_HASH SHAPE_POLY_SET::polygonChecksum( const POLYGON& aPoly )
+{
+    MD5_HASH hash;
+
+    hash.Hash( aPoly.size() );
+
+    for( const SHAPE_LINE_CHAIN& lc : aPoly )
+    {
+        hash.Hash( lc.PointCount() );
+
+        for( int i = 0; i < lc.PointCount(); i++ )
+        {
+            hash.Hash( lc.CPoint( i ).x );
+            hash.Hash( lc.CPoint( i ).y );
+        }
+    }
+
+    hash.Finalize();
+
+    return hash;
+}
+
+
 MD5_HASH SHAPE_POLY_SET::checksum() const
 {
     MD5_HASH hash;
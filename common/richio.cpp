@@ -28,6 +28,13 @@
 
 #include <richio.h>
 
+#if !defined( __WINDOWS__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 // Fall back to getc() when getc_unlocked() is not available on the target platform.
 #if !defined( HAVE_FGETC_NOLOCK )
@@ -225,13 +232,127 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
-STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
+MMAP_LINE_READER::MMAP_LINE_READER( const wxString& aFileName,
+            unsigned aStartingLineNumber, unsigned aMaxLineLength ):
+    LINE_READER( aMaxLineLength ), m_data( NULL ), m_size( 0 ), m_ndx( 0 )
+{
+    wxString msg = wxString::Format(
+        _( "Unable to open filename \"%s\" for reading" ), aFileName.GetData() );
+
+#if !defined( __WINDOWS__ )
+    int fd = open( aFileName.fn_str(), O_RDONLY );
+    struct stat st;
+
+    if( fd < 0 )
+        THROW_IO_ERROR( msg );
+
+    if( fstat( fd, &st ) != 0 )
+    {
+        close( fd );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_size = st.st_size;
+
+    // mmap() refuses empty mappings, an empty file simply has no line
+    if( m_size )
+    {
+        void* data = mmap( NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+        if( data != MAP_FAILED )
+        {
+            madvise( data, m_size, MADV_SEQUENTIAL );
+            m_data = (const char*) data;
+        }
+    }
+
+    close( fd );
+#endif
+
+    if( m_size && !m_data )
+    {
+        // No mapping available: read the whole file at once.  The text mode keeps the
+        // end of line conversions of FILE_LINE_READER on Windows.
+        FILE* fp = wxFopen( aFileName, wxT( "rt" ) );
+
+        if( !fp )
+            THROW_IO_ERROR( msg );
+
+        m_buffer.resize( 1 << 16 );
+        m_size = 0;
+
+        for( ;; )
+        {
+            m_size += fread( &m_buffer[m_size], 1, m_buffer.size() - m_size, fp );
+
+            if( m_size < m_buffer.size() )
+                break;
+
+            m_buffer.resize( m_buffer.size() * 2 );
+        }
+
+        bool failed = ferror( fp );
+        fclose( fp );
+
+        if( failed )
+            THROW_IO_ERROR( msg );
+
+        m_data = m_buffer.data();
+    }
+
+    m_source  = aFileName;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+MMAP_LINE_READER::~MMAP_LINE_READER()
+{
+#if !defined( __WINDOWS__ )
+    if( m_data && m_buffer.empty() )
+        munmap( (void*) m_data, m_size );
+#endif
+}
+
+
+char* MMAP_LINE_READER::ReadLine()
+{
+    const char* line = m_data + m_ndx;
+    size_t      remaining = m_size - m_ndx;
+    const char* eol = remaining ? (const char*) memchr( line, '\n', remaining ) : NULL;
+    size_t      length = eol ? eol - line + 1 : remaining;      // include the newline
+
+    if( length >= m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    if( length >= m_capacity )
+        expandCapacity( length + 1 );
+
+    // The line is copied: Line() must stay nul terminated, as the parse errors quote it,
+    // and the mapping is read only.  The line is in the cache after memchr(), so the
+    // copy is cheap.
+    memcpy( m_line, line, length );
+    m_line[length] = 0;
+
+    m_length = length;
+    m_ndx += length;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return m_length ? m_line : NULL;
+}
+
+
+STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource,
+                                        unsigned aStartingLineNumber ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
 {
     // Clipboard text should be nice and _use multiple lines_ so that
     // we can report _line number_ oriented error messages when parsing.
-    m_source = aSource;
+    m_source  = aSource;
+    m_lineNum = aStartingLineNumber;
 }
 
 
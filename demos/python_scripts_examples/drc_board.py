@@ -0,0 +1,90 @@
+'''
+    A python script example to run the DRC on a board without the board editor,
+    and to save the result in a machine readable form:
+        <board name>-drc.json: all the errors, and the time spent in each DRC pass
+        <board name>-drc.csv: one line per error
+
+    usage: python drc_board.py <board file> [output directory]
+
+    The exit code is the number of errors found (0 when the board is clean),
+    so the script can be used in a continuous integration job.
+
+    Important note:
+        the zones are tested as they are stored in the board file.
+        The script does not refill them.
+'''
+
+import sys
+import os
+import csv
+import json
+
+from pcbnew import *
+
+filename = sys.argv[1]
+outputDir = sys.argv[2] if len( sys.argv ) > 2 else "."
+
+board = LoadBoard( filename )
+
+drc = DRC( board, MILLIMETRES )
+
+# Pad to pad, unconnected items, zones, keepout areas; report all track errors
+drc.SetSettings( True, True, True, True, False, True, "", False )
+drc.RunBatchTests()
+
+def toMM( aPoint ):
+    return [ ToMM( aPoint.x ), ToMM( aPoint.y ) ]
+
+def drcItemData( aItem ):
+    data = { "code": aItem.GetErrorCode(),
+             "message": aItem.GetErrorText(),
+             "item_a": aItem.GetTextA(),
+             "pos_a": toMM( aItem.GetPointA() ) }
+
+    if aItem.HasSecondItem():
+        data[ "item_b" ] = aItem.GetTextB()
+        data[ "pos_b" ] = toMM( aItem.GetPointB() )
+
+    return data
+
+errors = []
+
+for ii in range( board.GetMARKERCount() ):
+    errors.append( drcItemData( board.GetMARKER( ii ).GetReporter() ) )
+
+unconnected = []
+
+for ii in range( drc.GetUnconnectedCount() ):
+    unconnected.append( drcItemData( drc.GetUnconnectedItem( ii ) ) )
+
+passes = []
+
+for ii in range( drc.GetPassCount() ):
+    passes.append( { "name": drc.GetPassName( ii ), "time_ms": drc.GetPassTime( ii ) } )
+
+basename = os.path.splitext( os.path.basename( filename ) )[0]
+
+with open( os.path.join( outputDir, basename + "-drc.json" ), "w" ) as jsonFile:
+    json.dump( { "board": filename,
+                 "errors": errors,
+                 "unconnected": unconnected,
+                 "passes": passes },
+               jsonFile, indent=2 )
+
+with open( os.path.join( outputDir, basename + "-drc.csv" ), "w" ) as csvFile:
+    writer = csv.writer( csvFile )
+    writer.writerow( [ "type", "code", "message", "item_a", "x_a", "y_a", "item_b", "x_b", "y_b" ] )
+
+    for kind, items in ( ( "error", errors ), ( "unconnected", unconnected ) ):
+        for item in items:
+            posB = item.get( "pos_b", [ "", "" ] )
+            writer.writerow( [ kind, item[ "code" ], item[ "message" ],
+                               item[ "item_a" ], item[ "pos_a" ][0], item[ "pos_a" ][1],
+                               item.get( "item_b", "" ), posB[0], posB[1] ] )
+
+for p in passes:
+    print( "%-20s %10.1f ms" % ( p[ "name" ], p[ "time_ms" ] ) )
+
+print( "%d errors, %d unconnected items" % ( len( errors ), len( unconnected ) ) )
+
+sys.exit( min( len( errors ) + len( unconnected ), 255 ) )
@@ -536,6 +536,9 @@ bool SCH_EDIT_FRAME::SchematicCleanUp( bool aAppend )
         itemList.PushItem( ITEM_PICKER( aItem, UR_DELETED ) );
     };
 
+    // The callers may have moved or edited items in place without telling the screen
+    screen->SetConnectivityDirty();
+
     BreakSegmentsOnJunctions( true );
 
     for( item = screen->GetDrawItems(); item; item = item->Next() )
@@ -39,6 +39,7 @@
 #include <sch_edit_frame.h>
 #include <sch_reference_list.h>
 #include <sch_component.h>
+#include <sch_screen.h>
 #include <reporter.h>
 
 
@@ -757,6 +758,9 @@ void SCH_REFERENCE::Annotate()
     m_RootCmp->SetRef( &m_SheetPath, FROM_UTF8( m_Ref.c_str() ) );
     m_RootCmp->SetUnit( m_Unit );
     m_RootCmp->SetUnitSelection( &m_SheetPath, m_Unit );
+
+    // The netlist cache of the screen holds the old reference and unit
+    m_SheetPath.LastScreen()->SetAnnotationDirty();
 }
 
 
@@ -40,6 +40,7 @@
 #include <kiface_i.h>
 #include <bitmaps.h>
 #include <reporter.h>
+#include <profile.h>
 #include <wildcards_and_files_ext.h>
 
 #include <netlist.h>
@@ -485,16 +486,35 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
     // Erase all previous DRC markers.
     screens.DeleteAllMarkers( MARKER_BASE::MARKER_ERC );
 
+    // Report the time taken by a rule
+    auto reportTotal = [&aReporter]( const wxString& aRule, double aMsecs )
+    {
+        aReporter.Report( wxString::Format( _( "%s: %.1f ms" ), aRule, aMsecs ),
+                          REPORTER::RPT_INFO );
+    };
+
+    // Report the time taken by a rule, measured by aTimer, and restart aTimer for the next one
+    auto reportTime = [&reportTotal]( const wxString& aRule, PROF_COUNTER& aTimer )
+    {
+        reportTotal( aRule, aTimer.msecs() );
+        aTimer.Start();
+    };
+
+    PROF_COUNTER timer;
+
     /* Test duplicate sheet names inside a given sheet, one cannot have sheets with
      * duplicate names (file names can be duplicated).
      */
     TestDuplicateSheetNames( true );
+    reportTime( _( "Duplicate sheet names" ), timer );
 
     /* Test is all units of each multiunit component have the same footprint assigned.
      */
     TestMultiunitFootprints( sheets );
+    reportTime( _( "Multiple unit footprints" ), timer );
 
     std::unique_ptr<NETLIST_OBJECT_LIST> objectsConnectedList( m_parent->BuildNetListBase() );
+    reportTime( _( "Netlist" ), timer );
 
     // Reset the connection type indicator
     objectsConnectedList->ResetConnectionsType();
@@ -509,6 +529,12 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
      */
     std::unordered_map<wxString, wxString> pin_to_net_map;
 
+    // The rules below run item by item, so their times are summed over the loop
+    double orphanLabelTime = 0.0;
+    double noConnectTime = 0.0;
+    double pinNetTime = 0.0;
+    double pinConnectionTime = 0.0;
+
     /* The netlist generated by SCH_EDIT_FRAME::BuildNetListBase is sorted
      * by net number, which means we can group netlist items into ranges
      * that live in the same net. The range from nextItem to the current
@@ -552,17 +578,27 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
         case NET_HIERBUSLABELMEMBER:
         case NET_SHEETLABEL:
         case NET_SHEETBUSLABELMEMBER:
+        {
             // ERC problems when pin sheets do not match hierarchical labels.
             // Each pin sheet must match a hierarchical label
             // Each hierarchical label must match a pin sheet
+            PROF_COUNTER ruleTimer;
             objectsConnectedList->TestforNonOrphanLabel( itemIdx, nextItemIdx );
+            orphanLabelTime += ruleTimer.msecs();
             break;
+        }
         case NET_GLOBLABEL:
             if( m_tstUniqueGlobalLabels )
+            {
+                PROF_COUNTER ruleTimer;
                 objectsConnectedList->TestforNonOrphanLabel( itemIdx, nextItemIdx );
+                orphanLabelTime += ruleTimer.msecs();
+            }
             break;
 
         case NET_NOCONNECT:
+        {
+            PROF_COUNTER ruleTimer;
 
             // ERC problems when a noconnect symbol is connected to more than one pin.
             MinConn = NET_NC;
@@ -570,10 +606,14 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
             if( objectsConnectedList->CountPinsInNet( nextItemIdx ) > 1 )
                 Diagnose( item, NULL, MinConn, UNC );
 
+            noConnectTime += ruleTimer.msecs();
             break;
+        }
 
         case NET_PIN:
         {
+            PROF_COUNTER ruleTimer;
+
             // Check if this pin has appeared before on a different net
             if( item->m_Link )
             {
@@ -600,8 +640,12 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
                 }
             }
 
+            pinNetTime += ruleTimer.msecs();
+            ruleTimer.Start();
+
             // Look for ERC problems between pins:
             TestOthersItems( objectsConnectedList.get(), itemIdx, nextItemIdx, &MinConn );
+            pinConnectionTime += ruleTimer.msecs();
             break;
         }
         }
@@ -609,10 +653,19 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
         lastItemIdx = itemIdx;
     }
 
+    reportTotal( _( "Orphan labels" ), orphanLabelTime );
+    reportTotal( _( "Pins connected to no connect symbols" ), noConnectTime );
+    reportTotal( _( "Pins of multiple units on different nets" ), pinNetTime );
+    reportTotal( _( "Pin to pin connections" ), pinConnectionTime );
+    timer.Start();
+
     // Test similar labels (i;e. labels which are identical when
     // using case insensitive comparisons)
     if( m_TestSimilarLabels )
+    {
         objectsConnectedList->TestforSimilarLabels();
+        reportTime( _( "Similar labels" ), timer );
+    }
 
     // Displays global results:
     updateMarkerCounts( &screens );
@@ -28,6 +28,8 @@
  * @brief Electrical Rules Check implementation.
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <class_drawpanel.h>
 #include <kicad_string.h>
@@ -470,37 +472,8 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList,
                      * TODO test also if instances connected are connected to
                      * the same net
                      */
-                    for( unsigned duplicate = 0; duplicate < aList->size(); duplicate++ )
-                    {
-                        if( aList->GetItemType( duplicate ) != NET_PIN )
-                            continue;
-
-                        if( duplicate == aNetItemRef )
-                            continue;
-
-                        if( aList->GetItem( aNetItemRef )->m_PinNum !=
-                            aList->GetItem( duplicate )->m_PinNum )
-                            continue;
-
-                        if( ( (SCH_COMPONENT*) aList->GetItem( aNetItemRef )->
-                             m_Link )->GetRef( &aList->GetItem( aNetItemRef )-> m_SheetPath ) !=
-                            ( (SCH_COMPONENT*) aList->GetItem( duplicate )->m_Link )
-                           ->GetRef( &aList->GetItem( duplicate )->m_SheetPath ) )
-                            continue;
-
-                        // Same component and same pin. Do dot create error for this pin
-                        // if the other pin is connected (i.e. if duplicate net has another
-                        // item)
-                        if( (duplicate > 0)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate - 1 ) ) )
-                            seterr = false;
-
-                        if( (duplicate < aList->size() - 1)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate + 1 ) ) )
-                            seterr = false;
-                    }
+                    if( aList->IsPinInstanceConnected( aNetItemRef ) )
+                        seterr = false;
                 }
 
                 if( seterr )
@@ -561,23 +534,97 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList,
     }
 }
 
-int NETLIST_OBJECT_LIST::CountPinsInNet( unsigned aNetStart )
+const NETLIST_OBJECT_LIST::ERC_NET_TALLY& NETLIST_OBJECT_LIST::ercNetTally( unsigned aNetStart )
 {
-    int count = 0;
+    auto it = m_ercNetTallies.find( aNetStart );
+
+    if( it != m_ercNetTallies.end() )
+        return it->second;
+
+    ERC_NET_TALLY& tally = m_ercNetTallies[aNetStart];
     int curr_net = GetItemNet( aNetStart );
 
-    /* Test pins connected to NetItemRef */
-    for( unsigned item = aNetStart; item < size(); item++ )
+    tally.m_pinCount = 0;
+
+    for( unsigned ii = aNetStart; ii < size(); ii++ )
     {
         // We examine only a given net. We stop the search if the net changes
-        if( curr_net != GetItemNet( item ) )   // End of net
+        if( curr_net != GetItemNet( ii ) )   // End of net
             break;
 
-        if( GetItemType( item ) == NET_PIN )
-            count++;
+        NETLIST_OBJECT* item = GetItem( ii );
+
+        switch( item->m_Type )
+        {
+        case NET_PIN:
+            tally.m_pinCount++;
+            break;
+
+        case NET_HIERLABEL:
+        case NET_HIERBUSLABELMEMBER:
+            tally.m_hierLabelSheets.insert( item->m_SheetPath );
+            break;
+
+        case NET_SHEETLABEL:
+        case NET_SHEETBUSLABELMEMBER:
+            tally.m_sheetLabelSheets.insert( item->m_SheetPathInclude );
+            break;
+
+        case NET_GLOBLABEL:
+            tally.m_globalLabels[item->m_Label]++;
+            break;
+
+        default:
+            break;
+        }
     }
 
-    return count;
+    return tally;
+}
+
+
+int NETLIST_OBJECT_LIST::CountPinsInNet( unsigned aNetStart )
+{
+    return ercNetTally( aNetStart ).m_pinCount;
+}
+
+
+std::pair<wxString, wxString> NETLIST_OBJECT_LIST::ercPinKey( unsigned aPinIdx ) const
+{
+    NETLIST_OBJECT* pin = GetItem( aPinIdx );
+    SCH_COMPONENT*  component = (SCH_COMPONENT*) pin->m_Link;
+
+    return std::make_pair( component->GetRef( &pin->m_SheetPath ), pin->m_PinNum );
+}
+
+
+bool NETLIST_OBJECT_LIST::IsPinInstanceConnected( unsigned aPinIdx )
+{
+    if( m_ercPinInstances.empty() )
+    {
+        for( unsigned ii = 0; ii < size(); ii++ )
+        {
+            if( GetItemType( ii ) == NET_PIN )
+                m_ercPinInstances[ercPinKey( ii )].push_back( ii );
+        }
+    }
+
+    for( unsigned duplicate : m_ercPinInstances[ercPinKey( aPinIdx )] )
+    {
+        if( duplicate == aPinIdx )
+            continue;
+
+        // Same component and same pin: the other pin is connected if its net has
+        // another item
+        if( ( duplicate > 0 ) && ( GetItemNet( duplicate ) == GetItemNet( duplicate - 1 ) ) )
+            return true;
+
+        if( ( duplicate < size() - 1 )
+          && ( GetItemNet( duplicate ) == GetItemNet( duplicate + 1 ) ) )
+            return true;
+    }
+
+    return false;
 }
 
 bool WriteDiagnosticERC( EDA_UNITS_T aUnits, const wxString& aFullFileName )
@@ -641,35 +688,40 @@ bool WriteDiagnosticERC( EDA_UNITS_T aUnits, const wxString& aFullFileName )
 
 void NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet )
 {
-    unsigned netItemTst = aStartNet;
-    int      erc = 1;
+    const ERC_NET_TALLY& tally = ercNetTally( aStartNet );
+    NETLIST_OBJECT*      label = GetItem( aNetItemRef );
+    bool                 connected = false;
 
-    // Review the list of labels connected to NetItemRef:
-    for( ; ; netItemTst++ )
+    // Look in the net for a label connected to this one, see
+    // NETLIST_OBJECT::IsLabelConnected()
+    switch( label->m_Type )
     {
-        if( netItemTst == aNetItemRef )
-            continue;
+    case NET_HIERLABEL:
+    case NET_HIERBUSLABELMEMBER:
+        connected = tally.m_sheetLabelSheets.count( label->m_SheetPath ) > 0;
+        break;
 
-        /* Is always in the same net? */
-        if( ( netItemTst == size() )
-          || ( GetItemNet( aNetItemRef ) != GetItemNet( netItemTst ) ) )
-        {
-            /* End Netcode found. */
-            if( erc )
-            {
-                /* Glabel or SheetLabel orphaned. */
-                Diagnose( GetItem( aNetItemRef ), NULL, -1, WAR );
-            }
+    case NET_SHEETLABEL:
+    case NET_SHEETBUSLABELMEMBER:
+        connected = tally.m_hierLabelSheets.count( label->m_SheetPathInclude ) > 0;
+        break;
 
-            return;
-        }
+    case NET_GLOBLABEL:
+    {
+        // Another global label having the same name
+        auto it = tally.m_globalLabels.find( label->m_Label );
+        connected = it != tally.m_globalLabels.end() && it->second > 1;
+        break;
+    }
 
-        if( GetItem( aNetItemRef )->IsLabelConnected( GetItem( netItemTst ) ) )
-            erc = 0;
+    default:
+        break;
+    }
 
-        //same thing, different order.
-        if( GetItem( netItemTst )->IsLabelConnected( GetItem( aNetItemRef ) ) )
-            erc = 0;
+    if( !connected )
+    {
+        /* Glabel or SheetLabel orphaned. */
+        Diagnose( label, NULL, -1, WAR );
     }
 }
 
@@ -678,38 +730,7 @@ void NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned
 // when they are compared using case insensitive coparisons.
 
 
-// A helper struct to compare NETLIST_OBJECT items by sheetpath and label texts
-// for a std::set<NETLIST_OBJECT*> container
-// the full text is "sheetpath+label" for local labels and "label" for global labels
-struct compare_labels
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        wxString str1 = lab1->m_SheetPath.Path() + lab1->m_Label;
-        wxString str2 = lab2->m_SheetPath.Path() + lab2->m_Label;
-
-        return str1.Cmp( str2 ) < 0;
-    }
-};
-
-struct compare_label_names
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        return lab1->m_Label.Cmp( lab2->m_Label ) < 0;
-    }
-};
-
-struct compare_paths
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        return lab1->m_SheetPath.Path().Cmp( lab2->m_SheetPath.Path() ) < 0;
-    }
-};
-
-// Helper functions to build the warning messages about Similar Labels:
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aLabel );
+// Helper function to build the warning messages about Similar Labels:
 static void SimilarLabelsDiagnose( NETLIST_OBJECT* aItemA, NETLIST_OBJECT* aItemB );
 
 
@@ -718,11 +739,14 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
     // Similar labels which are different when using case sensitive comparisons
     // but are equal when using case insensitive comparisons
 
-    // list of all labels (used the better item to build diag messages)
-    std::vector<NETLIST_OBJECT*> fullLabelList;
-    // list of all labels , each label appears only once (used to to detect similar labels)
-    std::set<NETLIST_OBJECT*, compare_labels> uniqueLabelList;
-    wxString msg;
+    // The labels, each label appears only once by sheet path, sorted by
+    // "sheetpath+label" (used to detect similar labels)
+    std::map<wxString, NETLIST_OBJECT*> uniqueLabelList;
+
+    // The number of global labels having a given name, and of labels having a given
+    // name in a given sheet path (used to choose the better item to build diag messages)
+    std::map<wxString, int> globalLabelCount;
+    std::map<std::pair<wxString, wxString>, int> localLabelCount;
 
     // Build a list of differents labels. If inside a given sheet there are
     // more than one given label, only one label is stored.
@@ -741,10 +765,19 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         case NET_HIERLABEL:
         case NET_HIERBUSLABELMEMBER:
         case NET_GLOBLABEL:
+        {
             // add this label in lists
-            uniqueLabelList.insert( GetItem( netItem ) );
-            fullLabelList.push_back( GetItem( netItem ) );
+            NETLIST_OBJECT* label = GetItem( netItem );
+            wxString        path = label->m_SheetPath.Path();
+
+            uniqueLabelList.insert( std::make_pair( path + label->m_Label, label ) );
+            localLabelCount[std::make_pair( path, label->m_Label )]++;
+
+            if( label->IsLabelGlobal() )
+                globalLabelCount[label->m_Label]++;
+
             break;
+        }
 
         case NET_SHEETLABEL:
         case NET_SHEETBUSLABELMEMBER:
@@ -753,118 +786,80 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         }
     }
 
-    // build global labels and compare
-    std::set<NETLIST_OBJECT*, compare_label_names> loc_labelList;
-    std::set<NETLIST_OBJECT*>::const_iterator it;
-
-    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
+    // Count the labels identical to aLabel:
+    //  for global label: global labels in the full project
+    //  for local label: all labels in the current sheet
+    auto countIdenticalLabels = [&]( NETLIST_OBJECT* aLabel ) -> int
     {
-        if( (*it)->IsLabelGlobal() )
-            loc_labelList.insert( *it );
-    }
-
-    // compare global labels (same label names appears only once in list)
-    for( it = loc_labelList.begin(); it != loc_labelList.end(); ++it )
-    {
-        std::set<NETLIST_OBJECT*>::const_iterator it_aux = it;
-
-        for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
-        {
-            if( (*it)->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
-            {
-                // Create new marker for ERC.
-                int cntA = countIndenticalLabels( fullLabelList, *it );
-                int cntB = countIndenticalLabels( fullLabelList, *it_aux );
-
-                if( cntA <= cntB )
-                    SimilarLabelsDiagnose( (*it), (*it_aux) );
-                else
-                    SimilarLabelsDiagnose( (*it_aux), (*it) );
-            }
-        }
-    }
+        if( aLabel->IsLabelGlobal() )
+            return globalLabelCount[aLabel->m_Label];
 
-    // Build paths list
-    std::set<NETLIST_OBJECT*, compare_paths> pathsList;
+        return localLabelCount[std::make_pair( aLabel->m_SheetPath.Path(), aLabel->m_Label )];
+    };
 
-    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
-        pathsList.insert( *it );
-
-    // Examine each label inside a sheet path:
-    for( it = pathsList.begin(); it != pathsList.end(); ++it )
+    // Diagnose the labels of aLabels, sorted by name and having different names, which
+    // are equal when using case insensitive comparisons.  The labels are grouped by their
+    // lower case name, so only the labels of a group are compared.
+    auto testLabels = [&]( const std::vector<NETLIST_OBJECT*>& aLabels, bool aSkipGlobalPairs )
     {
-        loc_labelList.clear();
-
-        std::set<NETLIST_OBJECT*>::const_iterator it_aux = uniqueLabelList.begin();
+        std::map<wxString, std::vector<unsigned>> similarLabels;
+        std::vector<wxString>                     folded;
 
-        for( ; it_aux != uniqueLabelList.end(); ++it_aux )
+        for( unsigned ii = 0; ii < aLabels.size(); ii++ )
         {
-            if( (*it)->m_SheetPath.Path() == (*it_aux)->m_SheetPath.Path() )
-                loc_labelList.insert( *it_aux );
+            folded.push_back( aLabels[ii]->m_Label.Lower() );
+            similarLabels[folded.back()].push_back( ii );
         }
 
-        // at this point, loc_labelList contains labels of the current sheet path.
-        // Detect similar labels (same label names appears only once in list)
-        std::set<NETLIST_OBJECT*>::const_iterator ref_it;
-
-        for( ref_it = loc_labelList.begin(); ref_it != loc_labelList.end(); ++ref_it )
+        for( unsigned ii = 0; ii < aLabels.size(); ii++ )
         {
-            NETLIST_OBJECT* ref_item = *ref_it;
-            it_aux = ref_it;
+            const std::vector<unsigned>& group = similarLabels[folded[ii]];
 
-            for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
+            for( auto jj = std::upper_bound( group.begin(), group.end(), ii );
+                 jj != group.end(); ++jj )
             {
-                // global label versus global label was already examined.
-                // here, at least one label must be local
-                if( ref_item->IsLabelGlobal() && (*it_aux)->IsLabelGlobal() )
+                NETLIST_OBJECT* labelA = aLabels[ii];
+                NETLIST_OBJECT* labelB = aLabels[*jj];
+
+                if( aSkipGlobalPairs && labelA->IsLabelGlobal() && labelB->IsLabelGlobal() )
                     continue;
 
-                if( ref_item->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
-                {
-                    // Create new marker for ERC.
-                    int cntA = countIndenticalLabels( fullLabelList, ref_item );
-                    int cntB = countIndenticalLabels( fullLabelList, *it_aux );
-
-                    if( cntA <= cntB )
-                        SimilarLabelsDiagnose( ref_item, (*it_aux) );
-                    else
-                        SimilarLabelsDiagnose( (*it_aux), ref_item );
-                }
+                // Create new marker for ERC.
+                if( countIdenticalLabels( labelA ) <= countIdenticalLabels( labelB ) )
+                    SimilarLabelsDiagnose( labelA, labelB );
+                else
+                    SimilarLabelsDiagnose( labelB, labelA );
             }
         }
-    }
-}
+    };
 
-// Helper function: count the number of labels identical to aLabel
-//  for global label: global labels in the full project
-//  for local label: all labels in the current sheet
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aLabel )
-{
-    int count = 0;
+    // build global labels and compare (same label names appears only once in list)
+    std::map<wxString, NETLIST_OBJECT*> globalLabelList;
 
-    if( aLabel->IsLabelGlobal() )
+    for( const auto& entry : uniqueLabelList )
     {
-        for( unsigned netItem = 0; netItem < aList.size(); ++netItem )
-        {
-            NETLIST_OBJECT* item = aList[netItem];
-
-            if( item->IsLabelGlobal() && item->m_Label == aLabel->m_Label )
-                count++;
-        }
+        if( entry.second->IsLabelGlobal() )
+            globalLabelList.insert( std::make_pair( entry.second->m_Label, entry.second ) );
     }
-    else
-    {
-        for( unsigned netItem = 0; netItem < aList.size(); ++netItem )
-        {
-            NETLIST_OBJECT* item = aList[netItem];
 
-            if( item->m_Label == aLabel->m_Label &&
-                item->m_SheetPath.Path() == aLabel->m_SheetPath.Path() )
-                count++;
-        }
-    }
+    std::vector<NETLIST_OBJECT*> labels;
+
+    for( const auto& entry : globalLabelList )
+        labels.push_back( entry.second );
+
+    testLabels( labels, false );
+
+    // Build the labels of each sheet path, sorted by name
+    std::map<wxString, std::vector<NETLIST_OBJECT*>> pathsList;
+
+    for( const auto& entry : uniqueLabelList )
+        pathsList[entry.second->m_SheetPath.Path()].push_back( entry.second );
 
-    return count;
+    // Examine each label inside a sheet path.
+    // global label versus global label was already examined.
+    // here, at least one label must be local
+    for( const auto& entry : pathsList )
+        testLabels( entry.second, true );
 }
 
 // Helper function: creates a marker for similar labels ERC warning
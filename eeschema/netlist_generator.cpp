@@ -235,16 +235,14 @@ bool SCH_EDIT_FRAME::CreateNetlist( int aFormat, const wxString& aFullFileName,
 
 NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::BuildNetListBase( bool updateStatusText )
 {
-    // I own this list until I return it to the new owner.
-    std::unique_ptr<NETLIST_OBJECT_LIST> ret( new NETLIST_OBJECT_LIST() );
-
     // Creates the flattened sheet list:
     SCH_SHEET_LIST aSheets( g_RootSheet );
 
-    // Build netlist info
-    bool success = ret->BuildNetListInfo( aSheets );
+    // Build netlist info, from the items of the sheets not modified since the last build
+    // I own this list until I return it to the new owner.
+    std::unique_ptr<NETLIST_OBJECT_LIST> ret( m_netListCache->BuildNetList( aSheets ) );
 
-    if( !success )
+    if( ret->size() == 0 )
     {
         if( updateStatusText )
             SetStatusText( _( "No Objects" ) );
@@ -42,16 +42,23 @@
  * The regular expression string for label bus notation.  Valid bus labels are defined as
  * one or more non-whitespace characters from the beginning of the string followed by the
  * bus notation [nn...mm] with no characters after the closing bracket.
+ * wxRegEx keeps the last match, so each thread reading net list items has its own.
  */
-static wxRegEx busLabelRe( wxT( "^([^[:space:]]+)(\\[[\\d]+\\.+[\\d]+\\])$" ), wxRE_ADVANCED );
+static wxRegEx& busLabelRe()
+{
+    static thread_local wxRegEx re( wxT( "^([^[:space:]]+)(\\[[\\d]+\\.+[\\d]+\\])$" ),
+                                    wxRE_ADVANCED );
+
+    return re;
+}
 
 
 bool IsBusLabel( const wxString& aLabel )
 {
-    wxCHECK_MSG( busLabelRe.IsValid(), false,
+    wxCHECK_MSG( busLabelRe().IsValid(), false,
                  wxT( "Invalid regular expression in IsBusLabel()." ) );
 
-    return busLabelRe.Matches( aLabel );
+    return busLabelRe().Matches( aLabel );
 }
 
 
@@ -258,8 +265,8 @@ void NETLIST_OBJECT::ConvertBusToNetListItems( NETLIST_OBJECT_LIST& aNetListItem
     wxString tmp, busName, busNumber;
     long begin, end, member;
 
-    busName = busLabelRe.GetMatch( m_Label, 1 );
-    busNumber = busLabelRe.GetMatch( m_Label, 2 );
+    busName = busLabelRe().GetMatch( m_Label, 1 );
+    busNumber = busLabelRe().GetMatch( m_Label, 2 );
 
     /* Search for  '[' because a bus label is like "busname[nn..mm]" */
     i = busNumber.Find( '[' );
@@ -36,6 +36,9 @@
 #include <lib_pin.h>
 #include <sch_item_struct.h>
 
+#include <map>
+#include <set>
+
 class NETLIST_OBJECT_LIST;
 class SCH_COMPONENT;
 
@@ -177,6 +180,8 @@ public:
      */
     bool HasNetNameCandidate() { return m_netNameCandidate != NULL; }
 
+    NETLIST_OBJECT* GetNetNameCandidate() const { return m_netNameCandidate; }
+
     /**
      * Function GetPinNum
      * returns a pin number in wxString form.  Pin numbers are not always
@@ -312,6 +317,14 @@ public:
      */
     bool BuildNetListInfo( SCH_SHEET_LIST& aSheets );
 
+    /**
+     * Function BuildNetListInfo
+     * same as above, for a list already holding the items of the sheets,
+     * in flattened sheet list order.
+     * @return true if OK, false is not item found
+     */
+    bool BuildNetListInfo();
+
     /**
      * Acces to an item in list
      */
@@ -385,6 +398,15 @@ public:
      */
     int CountPinsInNet( unsigned aNetStart );
 
+    /**
+     * Function IsPinInstanceConnected
+     * tells whether another instance of the pin aPinIdx, i.e. a pin having the same
+     * pin number in a component having the same reference, is connected to something.
+     * The pins shared by the units of a multiple part per package are such instances.
+     * @param aPinIdx = index in list of a NET_PIN item
+     */
+    bool IsPinInstanceConnected( unsigned aPinIdx );
+
     /**
      * Function TestforNonOrphanLabel
      * Sheet labels are expected to be connected to a hierarchical label.
@@ -416,10 +438,75 @@ public:
     #endif
 
 private:
+    /// The items of one sheet, indexed by position for the physical connection searches
+    class SHEET_INDEX;
+
+    /// What the ERC tests need to know about the items of a net, see ercNetTally()
+    struct ERC_NET_TALLY
+    {
+        int                     m_pinCount;
+        std::set<SCH_SHEETS>    m_hierLabelSheets;  ///< the paths of the hierarchical labels
+        std::set<SCH_SHEETS>    m_sheetLabelSheets; ///< the paths included by the sheet labels
+        std::map<wxString, int> m_globalLabels;     ///< the count of global labels by name
+    };
+
+    /// The tallies of the nets, by index of the first item of the net.  ERC runs on a
+    /// list sorted by net code and not modified anymore, so they are built once.
+    std::map<unsigned, ERC_NET_TALLY> m_ercNetTallies;
+
+    /// The indexes of the NET_PIN items, by component reference and pin number, built
+    /// by the first call to IsPinInstanceConnected()
+    std::map<std::pair<wxString, wxString>, std::vector<unsigned>> m_ercPinInstances;
+
+    /**
+     * Function ercNetTally
+     * @return the tally of the net starting at aNetStart, built the first time it is
+     * requested.
+     */
+    const ERC_NET_TALLY& ercNetTally( unsigned aNetStart );
+
+    /// @return the key of the NET_PIN item aPinIdx in m_ercPinInstances
+    std::pair<wxString, wxString> ercPinKey( unsigned aPinIdx ) const;
+
+    /// While building the list, the net codes (resp. bus net codes) merged into another
+    /// one: code i was merged into code m_netCodeParent[i]. Codes not merged into any other
+    /// are their own parent, or outside the vector.
+    std::vector<int> m_netCodeParent;
+    std::vector<int> m_busNetCodeParent;
+
+    /**
+     * Function netCode
+     * @return the net code (or bus net code if aIsBus is true) that aCode has been merged
+     * into by propagateNetCode(), i.e. the code the items having aCode now belong to.
+     */
+    int netCode( int aCode, bool aIsBus );
+
+    int itemNetCode( const NETLIST_OBJECT* aItem )
+    {
+        return netCode( aItem->GetNet(), false );
+    }
+
+    int itemBusNetCode( const NETLIST_OBJECT* aItem )
+    {
+        return netCode( aItem->m_BusNetCode, true );
+    }
+
+    /**
+     * Function connectSheetItems
+     * connects the items of the list physically connected, the list holding the items
+     * of a single sheet.  Their net codes and bus net codes are numbered from 1 up to
+     * m_lastNetCode and m_lastBusNetCode excluded.
+     * Can run concurrently for the lists of different sheets.
+     * @return false if an item has no type
+     */
+    bool connectSheetItems();
+
     /*
      * Propagate aNewNetCode to items having an internal netcode aOldNetCode
      * used to interconnect group of items already physically connected,
-     * when a new connection is found between aOldNetCode and aNewNetCode
+     * when a new connection is found between aOldNetCode and aNewNetCode.
+     * The items are not updated: the merge is recorded, and read back by netCode(),
+     * until BuildNetListInfo() gives each item its final codes.
      */
     void propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus );
 
@@ -427,8 +514,9 @@ private:
      * This function merges the net codes of groups of objects already connected
      * to labels (wires, bus, pins ... ) when 2 labels are equivalents
      * (i.e. group objects connected by labels)
+     * @param aLabels = the labels of the list having the name of aLabelRef, in list order
      */
-    void labelConnect( NETLIST_OBJECT* aLabelRef );
+    void labelConnect( NETLIST_OBJECT* aLabelRef, const std::vector<NETLIST_OBJECT*>& aLabels );
 
     /* Comparison function to sort by increasing Netcode the list of connected items
      */
@@ -447,19 +535,26 @@ private:
     /**
      * Propagate net codes from a parent sheet to an include sheet,
      * from a pin sheet connection
+     * @param aLabels = the labels of the list having the name of aSheetLabel, in list order
      */
-    void sheetLabelConnect( NETLIST_OBJECT* aSheetLabel );
+    void sheetLabelConnect( NETLIST_OBJECT* aSheetLabel,
+                            const std::vector<NETLIST_OBJECT*>& aLabels );
 
-    void pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, int start );
+    /**
+     * Search the items of the sheet of aRef having an end point on an end point of aRef
+     * and propagate the aRef net code to them.
+     * @param aIndex = the index of the items of the sheet of aRef
+     */
+    void pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, const SHEET_INDEX& aIndex );
 
     /**
      * Search connections between a junction and segments
      * Propagate the junction net code to objects connected by this junction.
      * The junction must have a valid net code
-     * The list of objects is expected sorted by sheets.
-     * Search is done from index aIdxStart to the last element of list
+     * @param aIndex = the index of the items of the sheet of aJonction
      */
-    void segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus, int aIdxStart );
+    void segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus,
+                                const SHEET_INDEX& aIndex );
 
 
     /**
@@ -494,6 +589,49 @@ private:
 };
 
 
+/**
+ * Class NETLIST_OBJECT_CACHE
+ * keeps the net list items of each sheet of the hierarchy, and the list of connected items
+ * built from them, between two builds.  The items of a sheet are read again only when the
+ * connectivity revision of its screen has changed, and the items are connected again only
+ * when the items of a sheet, or the sheets, have changed.
+ */
+class NETLIST_OBJECT_CACHE
+{
+public:
+    NETLIST_OBJECT_CACHE() :
+        m_connectedValid( false )
+    {
+    }
+
+    ~NETLIST_OBJECT_CACHE();
+
+    /**
+     * Function BuildNetList
+     * builds the list of connected items of \a aSheets, like
+     * NETLIST_OBJECT_LIST::BuildNetListInfo() does, from what was kept when nothing changed.
+     * @param aSheets = the flattened sheet list
+     * @return the list of connected items, owned by the caller
+     */
+    NETLIST_OBJECT_LIST* BuildNetList( SCH_SHEET_LIST& aSheets );
+
+    /** Delete all kept items */
+    void Clear();
+
+private:
+    struct SHEET_ITEMS
+    {
+        unsigned        m_revision;     ///< connectivity revision of the screen the items
+                                        ///< were read from
+        NETLIST_OBJECTS m_items;        ///< the items of the sheet, not connected
+    };
+
+    std::map<SCH_SHEETS, SHEET_ITEMS> m_sheets;     ///< the items of each sheet path
+    NETLIST_OBJECT_LIST m_connected;                ///< the items of all sheets, connected
+    bool                m_connectedValid;
+};
+
+
 /**
  * Function IsBusLabel
  * test if \a aLabel has a bus notation.
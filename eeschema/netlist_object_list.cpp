@@ -38,13 +38,133 @@
 #include <sch_text.h>
 #include <sch_sheet.h>
 #include <sch_screen.h>
+#include <trigo.h>
+#include <parallel_for.h>
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <unordered_map>
 
 #define IS_WIRE false
 #define IS_BUS true
 
 //#define NETLIST_DEBUG
 
+
+/**
+ * The items of one sheet, indexed for the physical connection searches: the items
+ * connectable to wires and to buses by end point, and the wire and bus segments by the
+ * line they lie on. The arrays are indexed by IS_WIRE / IS_BUS.
+ */
+class NETLIST_OBJECT_LIST::SHEET_INDEX
+{
+public:
+    struct POINT_HASH
+    {
+        size_t operator()( const wxPoint& aPoint ) const
+        {
+            unsigned long long key = ( (unsigned long long) (unsigned) aPoint.x << 32 )
+                                     | (unsigned) aPoint.y;
+
+            return std::hash<unsigned long long>()( key );
+        }
+    };
+
+    typedef std::unordered_map<wxPoint, std::vector<NETLIST_OBJECT*>, POINT_HASH> POINT_MAP;
+    typedef std::unordered_map<int, std::vector<NETLIST_OBJECT*>> LINE_MAP;
+
+    POINT_MAP m_ends[2];                        ///< items by m_Start and by m_End
+    LINE_MAP  m_horizontal[2];                  ///< segments with m_Start.y == m_End.y, by y
+    LINE_MAP  m_vertical[2];                    ///< other segments with m_Start.x == m_End.x, by x
+    std::vector<NETLIST_OBJECT*> m_oblique[2];  ///< the remaining segments
+
+    SHEET_INDEX( const NETLIST_OBJECT_LIST& aList, unsigned aStart, unsigned aEnd )
+    {
+        for( unsigned i = aStart; i < aEnd; i++ )
+        {
+            NETLIST_OBJECT* item = aList.GetItem( i );
+
+            for( int bus = IS_WIRE; bus <= IS_BUS; bus++ )
+            {
+                if( !isConnectable( item->m_Type, bus ) )
+                    continue;
+
+                m_ends[bus][item->m_Start].push_back( item );
+
+                if( item->m_End != item->m_Start )
+                    m_ends[bus][item->m_End].push_back( item );
+            }
+
+            if( item->m_Type == NET_SEGMENT || item->m_Type == NET_BUS )
+            {
+                int bus = item->m_Type == NET_BUS;
+
+                if( item->m_Start.y == item->m_End.y )
+                    m_horizontal[bus][item->m_Start.y].push_back( item );
+                else if( item->m_Start.x == item->m_End.x )
+                    m_vertical[bus][item->m_Start.x].push_back( item );
+                else
+                    m_oblique[bus].push_back( item );
+            }
+        }
+    }
+
+    /**
+     * Calls aFunc for the segments of type NET_SEGMENT (or NET_BUS if aIsBus is true) that
+     * may contain aPoint: those on the horizontal and vertical lines through aPoint, and
+     * the oblique ones.
+     */
+    template<typename FUNC>
+    void ForEachSegmentNear( const wxPoint& aPoint, bool aIsBus, FUNC aFunc ) const
+    {
+        auto horizontal = m_horizontal[aIsBus].find( aPoint.y );
+
+        if( horizontal != m_horizontal[aIsBus].end() )
+            std::for_each( horizontal->second.begin(), horizontal->second.end(), aFunc );
+
+        auto vertical = m_vertical[aIsBus].find( aPoint.x );
+
+        if( vertical != m_vertical[aIsBus].end() )
+            std::for_each( vertical->second.begin(), vertical->second.end(), aFunc );
+
+        std::for_each( m_oblique[aIsBus].begin(), m_oblique[aIsBus].end(), aFunc );
+    }
+
+private:
+    /// The item types pointToPointConnect() connects to wires, or to buses
+    static bool isConnectable( NETLIST_ITEM_T aType, bool aIsBus )
+    {
+        switch( aType )
+        {
+        case NET_SEGMENT:
+        case NET_PIN:
+        case NET_LABEL:
+        case NET_HIERLABEL:
+        case NET_GLOBLABEL:
+        case NET_SHEETLABEL:
+        case NET_PINLABEL:
+        case NET_NOCONNECT:
+            return !aIsBus;
+
+        case NET_BUS:
+        case NET_BUSLABELMEMBER:
+        case NET_SHEETBUSLABELMEMBER:
+        case NET_HIERBUSLABELMEMBER:
+        case NET_GLOBBUSLABELMEMBER:
+            return aIsBus;
+
+        case NET_JUNCTION:
+            return true;
+
+        case NET_ITEM_UNSPECIFIED:
+            break;
+        }
+
+        return false;
+    }
+};
+
+
 NETLIST_OBJECT_LIST::~NETLIST_OBJECT_LIST()
 {
     Clear();
@@ -62,6 +182,8 @@ void NETLIST_OBJECT_LIST::Clear()
     }
 
     clear();
+    m_ercNetTallies.clear();
+    m_ercPinInstances.clear();
 }
 
 
@@ -92,110 +214,68 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
         }
     }
 
+    return BuildNetListInfo();
+}
+
+
+bool NETLIST_OBJECT_LIST::BuildNetListInfo()
+{
+    SCH_SHEET_PATH* sheet;
+
     if( size() == 0 )
         return false;
 
     // Sort objects by Sheet
     SortListbySheet();
 
-    sheet = &(GetItem( 0 )->m_SheetPath);
-    m_lastNetCode = m_lastBusNetCode = 1;
+    // Connect the items of each sheet, sheets in parallel
+    std::vector<std::unique_ptr<NETLIST_OBJECT_LIST>> sheets;
 
-    for( unsigned ii = 0, istart = 0; ii < size(); ii++ )
+    for( unsigned istart = 0, iend; istart < size(); istart = iend )
     {
-        NETLIST_OBJECT* net_item = GetItem( ii );
+        sheet = &GetItem( istart )->m_SheetPath;
 
-        if( net_item->m_SheetPath != *sheet )   // Sheet change
+        for( iend = istart + 1; iend < size(); iend++ )
         {
-            sheet  = &(net_item->m_SheetPath);
-            istart = ii;
-        }
-
-        switch( net_item->m_Type )
-        {
-        case NET_ITEM_UNSPECIFIED:
-            wxMessageBox( wxT( "BuildNetListInfo() error" ) );
-            break;
-
-        case NET_PIN:
-        case NET_PINLABEL:
-        case NET_SHEETLABEL:
-        case NET_NOCONNECT:
-            if( net_item->GetNet() != 0 )
+            if( GetItem( iend )->m_SheetPath != *sheet )
                 break;
+        }
 
-        case NET_SEGMENT:
-            // Test connections point to point type without bus.
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
-
-            pointToPointConnect( net_item, IS_WIRE, istart );
-            break;
-
-        case NET_JUNCTION:
-            // Control of the junction outside BUS.
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
-
-            segmentToPointConnect( net_item, IS_WIRE, istart );
-
-            // Control of the junction, on BUS.
-            if( net_item->m_BusNetCode == 0 )
-            {
-                net_item->m_BusNetCode = m_lastBusNetCode;
-                m_lastBusNetCode++;
-            }
+        sheets.emplace_back( new NETLIST_OBJECT_LIST() );
+        sheets.back()->assign( begin() + istart, begin() + iend );
+    }
 
-            segmentToPointConnect( net_item, IS_BUS, istart );
-            break;
+    std::vector<char> valid( sheets.size() );
 
-        case NET_LABEL:
-        case NET_HIERLABEL:
-        case NET_GLOBLABEL:
-            // Test connections type junction without bus.
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
+    ParallelFor( sheets.size(), [&sheets, &valid]( size_t i )
+    {
+        valid[i] = sheets[i]->connectSheetItems();
+    } );
 
-            segmentToPointConnect( net_item, IS_WIRE, istart );
-            break;
+    // Each sheet numbered its nets from 1: move them after the nets of the previous sheets
+    m_lastNetCode = m_lastBusNetCode = 1;
+    m_netCodeParent.clear();
+    m_busNetCodeParent.clear();
 
-        case NET_SHEETBUSLABELMEMBER:
-            if( net_item->m_BusNetCode != 0 )
-                break;
+    for( unsigned i = 0; i < sheets.size(); i++ )
+    {
+        if( !valid[i] )
+            wxMessageBox( wxT( "BuildNetListInfo() error" ) );
 
-        case NET_BUS:
-            // Control type connections point to point mode bus
-            if( net_item->m_BusNetCode == 0 )
-            {
-                net_item->m_BusNetCode = m_lastBusNetCode;
-                m_lastBusNetCode++;
-            }
+        for( NETLIST_OBJECT* item : *sheets[i] )
+        {
+            if( item->GetNet() )
+                item->SetNet( item->GetNet() + m_lastNetCode - 1 );
 
-            pointToPointConnect( net_item, IS_BUS, istart );
-            break;
+            if( item->m_BusNetCode )
+                item->m_BusNetCode += m_lastBusNetCode - 1;
+        }
 
-        case NET_BUSLABELMEMBER:
-        case NET_HIERBUSLABELMEMBER:
-        case NET_GLOBBUSLABELMEMBER:
-            // Control connections similar has on BUS
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->m_BusNetCode = m_lastBusNetCode;
-                m_lastBusNetCode++;
-            }
+        m_lastNetCode += sheets[i]->m_lastNetCode - 1;
+        m_lastBusNetCode += sheets[i]->m_lastBusNetCode - 1;
 
-            segmentToPointConnect( net_item, IS_BUS, istart );
-            break;
-        }
+        // The items belong to this list
+        sheets[i]->clear();
     }
 
 #if defined(NETLIST_DEBUG) && defined(DEBUG)
@@ -206,6 +286,15 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     // Updating the Bus Labels Netcode connected by Bus
     connectBusLabels();
 
+    // The labels by name, for labelConnect() and sheetLabelConnect()
+    std::map<wxString, std::vector<NETLIST_OBJECT*>> labels;
+
+    for( NETLIST_OBJECT* item : *this )
+    {
+        if( item->IsLabelType() )
+            labels[item->m_Label].push_back( item );
+    }
+
     // Group objects by label.
     for( unsigned ii = 0; ii < size(); ii++ )
     {
@@ -224,7 +313,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
         case NET_PINLABEL:
         case NET_BUSLABELMEMBER:
         case NET_GLOBBUSLABELMEMBER:
-            labelConnect( GetItem( ii ) );
+            labelConnect( GetItem( ii ), labels[GetItem( ii )->m_Label] );
             break;
 
         case NET_SHEETBUSLABELMEMBER:
@@ -247,9 +336,19 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     {
         if( GetItem( ii )->m_Type == NET_SHEETLABEL
             || GetItem( ii )->m_Type == NET_SHEETBUSLABELMEMBER )
-            sheetLabelConnect( GetItem( ii ) );
+            sheetLabelConnect( GetItem( ii ), labels[GetItem( ii )->m_Label] );
     }
 
+    // Give each item the codes its own codes have been merged into
+    for( NETLIST_OBJECT* item : *this )
+    {
+        item->SetNet( itemNetCode( item ) );
+        item->m_BusNetCode = itemBusNetCode( item );
+    }
+
+    m_netCodeParent.clear();
+    m_busNetCodeParent.clear();
+
     // Sort objects by NetCode
     SortListbyNetcode();
 
@@ -497,256 +596,309 @@ void NETLIST_OBJECT_LIST::findBestNetNameForEachNet()
 }
 
 
-void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
+bool NETLIST_OBJECT_LIST::connectSheetItems()
 {
-    if( SheetLabel->GetNet() == 0 )
-        return;
+    bool valid = true;
+
+    m_lastNetCode = m_lastBusNetCode = 1;
+    m_netCodeParent.clear();
+    m_busNetCodeParent.clear();
+
+    SHEET_INDEX index( *this, 0, size() );
 
     for( unsigned ii = 0; ii < size(); ii++ )
     {
-        NETLIST_OBJECT* ObjetNet = GetItem( ii );
+        NETLIST_OBJECT* net_item = GetItem( ii );
 
-        if( ObjetNet->m_SheetPath != SheetLabel->m_SheetPathInclude )
-            continue;  //use SheetInclude, not the sheet!!
+        switch( net_item->m_Type )
+        {
+        case NET_ITEM_UNSPECIFIED:
+            valid = false;
+            break;
 
-        if( (ObjetNet->m_Type != NET_HIERLABEL ) && (ObjetNet->m_Type != NET_HIERBUSLABELMEMBER ) )
-            continue;
+        case NET_PIN:
+        case NET_PINLABEL:
+        case NET_SHEETLABEL:
+        case NET_NOCONNECT:
+            if( itemNetCode( net_item ) != 0 )
+                break;
 
-        if( ObjetNet->GetNet() == SheetLabel->GetNet() )
-            continue;  //already connected.
+        case NET_SEGMENT:
+            // Test connections point to point type without bus.
+            if( itemNetCode( net_item ) == 0 )
+            {
+                net_item->SetNet( m_lastNetCode );
+                m_lastNetCode++;
+            }
 
-        if( ObjetNet->m_Label != SheetLabel->m_Label )
-            continue;  //different names.
+            pointToPointConnect( net_item, IS_WIRE, index );
+            break;
 
-        // Propagate Netcode having all the objects of the same Netcode.
-        if( ObjetNet->GetNet() )
-            propagateNetCode( ObjetNet->GetNet(), SheetLabel->GetNet(), IS_WIRE );
-        else
-            ObjetNet->SetNet( SheetLabel->GetNet() );
-    }
-}
+        case NET_JUNCTION:
+            // Control of the junction outside BUS.
+            if( itemNetCode( net_item ) == 0 )
+            {
+                net_item->SetNet( m_lastNetCode );
+                m_lastNetCode++;
+            }
 
+            segmentToPointConnect( net_item, IS_WIRE, index );
 
-void NETLIST_OBJECT_LIST::connectBusLabels()
-{
-    // Propagate the net code between all bus label member objects connected by they name.
-    // If the net code is not yet existing, a new one is created
-    // Search is done in the entire list
-    for( unsigned ii = 0; ii < size(); ii++ )
-    {
-        NETLIST_OBJECT* Label = GetItem( ii );
+            // Control of the junction, on BUS.
+            if( itemBusNetCode( net_item ) == 0 )
+            {
+                net_item->m_BusNetCode = m_lastBusNetCode;
+                m_lastBusNetCode++;
+            }
 
-        if( Label->IsLabelBusMemberType() )
-        {
-            if( Label->GetNet() == 0 )
+            segmentToPointConnect( net_item, IS_BUS, index );
+            break;
+
+        case NET_LABEL:
+        case NET_HIERLABEL:
+        case NET_GLOBLABEL:
+            // Test connections type junction without bus.
+            if( itemNetCode( net_item ) == 0 )
             {
-                // Not yet existiing net code: create a new one.
-                Label->SetNet( m_lastNetCode );
+                net_item->SetNet( m_lastNetCode );
                 m_lastNetCode++;
             }
 
-            for( unsigned jj = ii + 1; jj < size(); jj++ )
-            {
-                NETLIST_OBJECT* LabelInTst =  GetItem( jj );
+            segmentToPointConnect( net_item, IS_WIRE, index );
+            break;
 
-                if( LabelInTst->IsLabelBusMemberType() )
-                {
-                    if( LabelInTst->m_BusNetCode != Label->m_BusNetCode )
-                        continue;
+        case NET_SHEETBUSLABELMEMBER:
+            if( itemBusNetCode( net_item ) != 0 )
+                break;
+
+        case NET_BUS:
+            // Control type connections point to point mode bus
+            if( itemBusNetCode( net_item ) == 0 )
+            {
+                net_item->m_BusNetCode = m_lastBusNetCode;
+                m_lastBusNetCode++;
+            }
 
-                    if( LabelInTst->m_Member != Label->m_Member )
-                        continue;
+            pointToPointConnect( net_item, IS_BUS, index );
+            break;
 
-                    if( LabelInTst->GetNet() == 0 )
-                        // Append this object to the current net
-                        LabelInTst->SetNet( Label->GetNet() );
-                    else
-                        // Merge the 2 net codes, they are connected.
-                        propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
-                }
+        case NET_BUSLABELMEMBER:
+        case NET_HIERBUSLABELMEMBER:
+        case NET_GLOBBUSLABELMEMBER:
+            // Control connections similar has on BUS
+            if( itemNetCode( net_item ) == 0 )
+            {
+                net_item->m_BusNetCode = m_lastBusNetCode;
+                m_lastBusNetCode++;
             }
+
+            segmentToPointConnect( net_item, IS_BUS, index );
+            break;
         }
     }
+
+    for( NETLIST_OBJECT* item : *this )
+    {
+        item->SetNet( itemNetCode( item ) );
+        item->m_BusNetCode = itemBusNetCode( item );
+    }
+
+    m_netCodeParent.clear();
+    m_busNetCodeParent.clear();
+
+    return valid;
 }
 
 
-void NETLIST_OBJECT_LIST::propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus )
+void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel,
+                                             const std::vector<NETLIST_OBJECT*>& aLabels )
 {
-    if( aOldNetCode == aNewNetCode )
+    if( itemNetCode( SheetLabel ) == 0 )
         return;
 
-    if( aIsBus == false )    // Propagate NetCode
+    for( NETLIST_OBJECT* ObjetNet : aLabels )
     {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* object = GetItem( jj );
+        if( ObjetNet->m_SheetPath != SheetLabel->m_SheetPathInclude )
+            continue;  //use SheetInclude, not the sheet!!
 
-            if( object->GetNet() == aOldNetCode )
-                object->SetNet( aNewNetCode );
-        }
-    }
-    else               // Propagate BusNetCode
-    {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* object = GetItem( jj );
+        if( (ObjetNet->m_Type != NET_HIERLABEL ) && (ObjetNet->m_Type != NET_HIERBUSLABELMEMBER ) )
+            continue;
 
-            if( object->m_BusNetCode == aOldNetCode )
-                object->m_BusNetCode = aNewNetCode;
-        }
+        int netCode = itemNetCode( ObjetNet );
+
+        if( netCode == itemNetCode( SheetLabel ) )
+            continue;  //already connected.
+
+        // Propagate Netcode having all the objects of the same Netcode.
+        if( netCode )
+            propagateNetCode( netCode, itemNetCode( SheetLabel ), IS_WIRE );
+        else
+            ObjetNet->SetNet( itemNetCode( SheetLabel ) );
     }
 }
 
 
-void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, int start )
+void NETLIST_OBJECT_LIST::connectBusLabels()
 {
-    int netCode;
+    // Propagate the net code between all bus label member objects connected by they name.
+    // If the net code is not yet existing, a new one is created
+    // The bus label members are grouped by bus net code and member: the first member of
+    // each group gives its net code to the others. Groups are handled by order of their
+    // first member in list.
+    std::map<std::pair<int, int>, std::vector<NETLIST_OBJECT*>> groups;
+    std::vector<std::vector<NETLIST_OBJECT*>*> groupOrder;
 
-    if( aIsBus == false )    // Objects other than BUS and BUSLABELS
+    for( NETLIST_OBJECT* item : *this )
     {
-        netCode = aRef->GetNet();
+        if( !item->IsLabelBusMemberType() )
+            continue;
 
-        for( unsigned i = start; i < size(); i++ )
-        {
-            NETLIST_OBJECT* item = GetItem( i );
+        auto& group = groups[std::make_pair( itemBusNetCode( item ), item->m_Member )];
 
-            if( item->m_SheetPath != aRef->m_SheetPath )  //used to be > (why?)
-                continue;
+        if( group.empty() )
+            groupOrder.push_back( &group );
 
-            switch( item->m_Type )
-            {
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_JUNCTION:
-            case NET_NOCONNECT:
-                if( aRef->m_Start == item->m_Start
-                    || aRef->m_Start == item->m_End
-                    || aRef->m_End   == item->m_Start
-                    || aRef->m_End   == item->m_End )
-                {
-                    if( item->GetNet() == 0 )
-                        item->SetNet( netCode );
-                    else
-                        propagateNetCode( item->GetNet(), netCode, IS_WIRE );
-                }
-                break;
-
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_ITEM_UNSPECIFIED:
-                break;
-            }
-        }
+        group.push_back( item );
     }
-    else    // Object type BUS, BUSLABELS, and junctions.
+
+    for( std::vector<NETLIST_OBJECT*>* group : groupOrder )
     {
-        netCode = aRef->m_BusNetCode;
+        NETLIST_OBJECT* Label = group->front();
 
-        for( unsigned i = start; i < size(); i++ )
+        if( itemNetCode( Label ) == 0 )
         {
-            NETLIST_OBJECT* item = GetItem( i );
-
-            if( item->m_SheetPath != aRef->m_SheetPath )
-                continue;
+            // Not yet existiing net code: create a new one.
+            Label->SetNet( m_lastNetCode );
+            m_lastNetCode++;
+        }
 
-            switch( item->m_Type )
-            {
-            case NET_ITEM_UNSPECIFIED:
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_NOCONNECT:
-                break;
+        for( unsigned jj = 1; jj < group->size(); jj++ )
+        {
+            NETLIST_OBJECT* LabelInTst = (*group)[jj];
 
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_JUNCTION:
-                if(  aRef->m_Start == item->m_Start
-                  || aRef->m_Start == item->m_End
-                  || aRef->m_End   == item->m_Start
-                  || aRef->m_End   == item->m_End )
-                {
-                    if( item->m_BusNetCode == 0 )
-                        item->m_BusNetCode = netCode;
-                    else
-                        propagateNetCode( item->m_BusNetCode, netCode, IS_BUS );
-                }
-                break;
-            }
+            if( itemNetCode( LabelInTst ) == 0 )
+                // Append this object to the current net
+                LabelInTst->SetNet( itemNetCode( Label ) );
+            else
+                // Merge the 2 net codes, they are connected.
+                propagateNetCode( itemNetCode( LabelInTst ), itemNetCode( Label ), IS_WIRE );
         }
     }
 }
 
 
-void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
-                                                 bool aIsBus, int aIdxStart )
+int NETLIST_OBJECT_LIST::netCode( int aCode, bool aIsBus )
 {
-    for( unsigned i = aIdxStart; i < size(); i++ )
+    std::vector<int>& parent = aIsBus ? m_busNetCodeParent : m_netCodeParent;
+
+    while( aCode < (int) parent.size() && parent[aCode] != aCode )
     {
-        NETLIST_OBJECT* segment = GetItem( i );
+        // Shorten the path for the next searches
+        parent[aCode] = parent[parent[aCode]];
+        aCode = parent[aCode];
+    }
 
-        // if different sheets, obviously no physical connection between elements.
-        if( segment->m_SheetPath != aJonction->m_SheetPath )
-            continue;
+    return aCode;
+}
 
-        if( aIsBus == IS_WIRE )
-        {
-            if( segment->m_Type != NET_SEGMENT )
-                continue;
-        }
-        else
-        {
-            if( segment->m_Type != NET_BUS )
-                continue;
-        }
 
-        if( IsPointOnSegment( segment->m_Start, segment->m_End, aJonction->m_Start ) )
+void NETLIST_OBJECT_LIST::propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus )
+{
+    aOldNetCode = netCode( aOldNetCode, aIsBus );
+    aNewNetCode = netCode( aNewNetCode, aIsBus );
+
+    if( aOldNetCode == aNewNetCode )
+        return;
+
+    std::vector<int>& parent = aIsBus ? m_busNetCodeParent : m_netCodeParent;
+
+    while( (int) parent.size() <= std::max( aOldNetCode, aNewNetCode ) )
+        parent.push_back( parent.size() );
+
+    // The items having aOldNetCode now have aNewNetCode
+    parent[aOldNetCode] = aNewNetCode;
+}
+
+
+void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus,
+                                               const SHEET_INDEX& aIndex )
+{
+    // The items of the sheet sharing an end point with aRef, and connectable to it
+    const SHEET_INDEX::POINT_MAP& ends = aIndex.m_ends[aIsBus];
+    const wxPoint* refEnds[2] = { &aRef->m_Start, &aRef->m_End };
+    int netCode;
+
+    if( aIsBus == false )    // Objects other than BUS and BUSLABELS
+        netCode = itemNetCode( aRef );
+    else                     // Object type BUS, BUSLABELS, and junctions.
+        netCode = itemBusNetCode( aRef );
+
+    for( const wxPoint* refEnd : refEnds )
+    {
+        auto candidates = ends.find( *refEnd );
+
+        if( candidates == ends.end() )
+            continue;
+
+        for( NETLIST_OBJECT* item : candidates->second )
         {
-            // Propagation Netcode has all the objects of the same Netcode.
-            if( aIsBus == IS_WIRE )
+            if( aIsBus == false )
             {
-                if( segment->GetNet() )
-                    propagateNetCode( segment->GetNet(), aJonction->GetNet(), aIsBus );
+                if( itemNetCode( item ) == 0 )
+                    item->SetNet( netCode );
                 else
-                    segment->SetNet( aJonction->GetNet() );
+                    propagateNetCode( itemNetCode( item ), netCode, IS_WIRE );
             }
             else
             {
-                if( segment->m_BusNetCode )
-                    propagateNetCode( segment->m_BusNetCode, aJonction->m_BusNetCode, aIsBus );
+                if( itemBusNetCode( item ) == 0 )
+                    item->m_BusNetCode = netCode;
                 else
-                    segment->m_BusNetCode = aJonction->m_BusNetCode;
+                    propagateNetCode( itemBusNetCode( item ), netCode, IS_BUS );
             }
         }
     }
 }
 
 
-void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
+void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
+                                                 bool aIsBus, const SHEET_INDEX& aIndex )
+{
+    aIndex.ForEachSegmentNear( aJonction->m_Start, aIsBus,
+            [&]( NETLIST_OBJECT* segment )
+            {
+                if( !IsPointOnSegment( segment->m_Start, segment->m_End, aJonction->m_Start ) )
+                    return;
+
+                // Propagation Netcode has all the objects of the same Netcode.
+                if( aIsBus == IS_WIRE )
+                {
+                    if( itemNetCode( segment ) )
+                        propagateNetCode( itemNetCode( segment ), itemNetCode( aJonction ), aIsBus );
+                    else
+                        segment->SetNet( itemNetCode( aJonction ) );
+                }
+                else
+                {
+                    if( itemBusNetCode( segment ) )
+                        propagateNetCode( itemBusNetCode( segment ), itemBusNetCode( aJonction ),
+                                          aIsBus );
+                    else
+                        segment->m_BusNetCode = itemBusNetCode( aJonction );
+                }
+            } );
+}
+
+
+void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef,
+                                        const std::vector<NETLIST_OBJECT*>& aLabels )
 {
-    if( aLabelRef->GetNet() == 0 )
+    if( itemNetCode( aLabelRef ) == 0 )
         return;
 
-    for( unsigned i = 0; i < size(); i++ )
+    for( NETLIST_OBJECT* item : aLabels )
     {
-        NETLIST_OBJECT* item = GetItem( i );
-
-        if( item->GetNet() == aLabelRef->GetNet() )
+        if( itemNetCode( item ) == itemNetCode( aLabelRef ) )
             continue;
 
         if( item->m_SheetPath != aLabelRef->m_SheetPath )
@@ -766,16 +918,11 @@ void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
         // NET_LABEL are local to a sheet
         // NET_GLOBLABEL are global.
         // NET_PINLABEL is a kind of global label (generated by a power pin invisible)
-        if( item->IsLabelType() )
-        {
-            if( item->m_Label != aLabelRef->m_Label )
-                continue;
-
-            if( item->GetNet() )
-                propagateNetCode( item->GetNet(), aLabelRef->GetNet(), IS_WIRE );
-            else
-                item->SetNet( aLabelRef->GetNet() );
-        }
+        // aLabels only holds labels (IsLabelType() items) having the name of aLabelRef
+        if( itemNetCode( item ) )
+            propagateNetCode( itemNetCode( item ), itemNetCode( aLabelRef ), IS_WIRE );
+        else
+            item->SetNet( itemNetCode( aLabelRef ) );
     }
 }
 
@@ -866,3 +1013,114 @@ void NETLIST_OBJECT_LIST::setUnconnectedFlag()
         }
     }
 }
+
+
+NETLIST_OBJECT_CACHE::~NETLIST_OBJECT_CACHE()
+{
+    Clear();
+}
+
+
+void NETLIST_OBJECT_CACHE::Clear()
+{
+    for( auto& sheet : m_sheets )
+    {
+        for( NETLIST_OBJECT* item : sheet.second.m_items )
+            delete item;
+    }
+
+    m_sheets.clear();
+    m_connected.Clear();
+    m_connectedValid = false;
+}
+
+
+NETLIST_OBJECT_LIST* NETLIST_OBJECT_CACHE::BuildNetList( SCH_SHEET_LIST& aSheets )
+{
+    std::map<SCH_SHEETS, SHEET_ITEMS> sheets;
+    std::vector<std::pair<SCH_SHEET_PATH*, SHEET_ITEMS*>> toRead;
+    bool changed = !m_connectedValid;
+
+    for( unsigned i = 0; i < aSheets.size(); i++ )
+    {
+        SCH_SHEET_PATH* sheet = &aSheets[i];
+        SCH_SCREEN* screen = sheet->LastScreen();
+        SHEET_ITEMS& sheetItems = sheets[*sheet];
+        auto cached = m_sheets.find( *sheet );
+
+        sheetItems.m_revision = screen->GetConnectivityRevision();
+
+        if( cached != m_sheets.end() && cached->second.m_revision == sheetItems.m_revision )
+        {
+            sheetItems.m_items.swap( cached->second.m_items );
+            m_sheets.erase( cached );
+        }
+        else
+        {
+            toRead.push_back( std::make_pair( sheet, &sheetItems ) );
+        }
+    }
+
+    // Read the items of the new or modified sheets, in parallel
+    ParallelFor( toRead.size(), [&toRead]( size_t i )
+    {
+        SCH_SHEET_PATH* sheet = toRead[i].first;
+        NETLIST_OBJECT_LIST items;
+
+        for( SCH_ITEM* item = sheet->LastScreen()->GetDrawItems(); item; item = item->Next() )
+            item->GetNetListItem( items, sheet );
+
+        toRead[i].second->m_items.swap( items );
+    } );
+
+    if( !toRead.empty() )
+        changed = true;
+
+    // What is left belongs to modified or removed sheets
+    for( auto& stale : m_sheets )
+    {
+        for( NETLIST_OBJECT* item : stale.second.m_items )
+            delete item;
+
+        changed = true;
+    }
+
+    m_sheets.swap( sheets );
+
+    if( changed )
+    {
+        m_connected.Clear();
+
+        for( unsigned i = 0; i < aSheets.size(); i++ )
+        {
+            for( NETLIST_OBJECT* item : m_sheets[aSheets[i]].m_items )
+                m_connected.push_back( new NETLIST_OBJECT( *item ) );
+        }
+
+        m_connected.BuildNetListInfo();
+    }
+
+    m_connectedValid = true;
+
+    // Give the caller its own copy, the net name candidates pointing to the copied items
+    NETLIST_OBJECT_LIST* list = new NETLIST_OBJECT_LIST();
+    std::unordered_map<NETLIST_OBJECT*, NETLIST_OBJECT*> copies;
+
+    list->reserve( m_connected.size() );
+
+    for( NETLIST_OBJECT* item : m_connected )
+    {
+        NETLIST_OBJECT* copy = new NETLIST_OBJECT( *item );
+
+        copies[item] = copy;
+        list->push_back( copy );
+    }
+
+    for( NETLIST_OBJECT* copy : *list )
+    {
+        if( copy->HasNetNameCandidate() )
+            copy->SetNetNameCandidate( copies[copy->GetNetNameCandidate()] );
+    }
+
+    return list;
+}
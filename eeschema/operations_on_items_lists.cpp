@@ -120,6 +120,9 @@ void SCH_EDIT_FRAME::CheckListConnections( PICKED_ITEMS_LIST& aItemsList, bool a
     std::vector< wxPoint > pts;
     std::vector< wxPoint > connections;
 
+    // The items of the list were just moved or pasted in place
+    GetScreen()->SetConnectivityDirty();
+
     GetSchematicConnections( connections );
     for( unsigned ii = 0; ii < aItemsList.GetCount(); ii++ )
     {
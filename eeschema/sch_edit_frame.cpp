@@ -371,6 +371,7 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     m_findReplaceData = new wxFindReplaceData( wxFR_DOWN );
     m_findReplaceStatus = new wxString( wxEmptyString );
     m_undoItem = NULL;
+    m_netListCache = new NETLIST_OBJECT_CACHE;
     m_hasAutoSave = true;
 
     SetForceHVLines( true );
@@ -461,12 +462,14 @@ SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
 
     delete m_CurrentSheet;          // a SCH_SHEET_PATH, on the heap.
     delete m_undoItem;
+    delete m_netListCache;
     delete g_RootSheet;
     delete m_findReplaceData;
     delete m_findReplaceStatus;
 
     m_CurrentSheet = NULL;
     m_undoItem = NULL;
+    m_netListCache = NULL;
     g_RootSheet = NULL;
     m_findReplaceData = NULL;
     m_findReplaceStatus = NULL;
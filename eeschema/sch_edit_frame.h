@@ -65,6 +65,7 @@ class wxFindDialogEvent;
 class wxFindReplaceData;
 class SCHLIB_FILTER;
 class RESCUER;
+class NETLIST_OBJECT_CACHE;
 
 
 /// enum used in RotationMiroir()
@@ -143,6 +144,8 @@ private:
     SCH_COLLECTOR           m_collectedItems;     ///< List of collected items.
     SCH_FIND_COLLECTOR      m_foundItems;         ///< List of find/replace items.
     SCH_ITEM*               m_undoItem;           ///< Copy of the current item being edited.
+    NETLIST_OBJECT_CACHE*   m_netListCache;       ///< Net list items kept between two
+                                                  ///< BuildNetListBase() calls.
     wxString                m_simulatorCommand;   ///< Command line used to call the circuit
                                                   ///< simulator (gnucap, spice, ...)
     wxString                m_netListerCommand;   ///< Command line to call a custom net list
@@ -533,6 +536,8 @@ public:
     /**
      * Create a flat list which stores all connected objects.
      *
+     * Only the sheets modified since the previous call are read again.
+     *
      * @param updateStatusText decides if window StatusText should be modified.
      * @return NETLIST_OBJECT_LIST* - caller owns the object.
      */
@@ -29,6 +29,8 @@
  * @brief Implementation of SCH_SCREEN and SCH_SCREENS classes.
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <gr_basic.h>
 #include <common.h>
@@ -89,12 +91,19 @@ static GRID_TYPE SchematicGridList[] = {
 };
 
 
+/// The last connectivity revision given to a screen
+static unsigned s_lastConnectivityRevision = 0;
+
+
 SCH_SCREEN::SCH_SCREEN( KIWAY* aKiway ) :
     BASE_SCREEN( SCH_SCREEN_T ),
     KIWAY_HOLDER( aKiway ),
     m_paper( wxT( "A4" ) )
 {
     m_modification_sync = 0;
+    m_connectivityRevision = ++s_lastConnectivityRevision;
+    m_itemIndexValid = false;
+    m_lastItemSequence = 0;
 
     SetZoom( 32 );
 
@@ -135,6 +144,120 @@ void SCH_SCREEN::DecRefCount()
 }
 
 
+void SCH_SCREEN::newConnectivityRevision()
+{
+    m_connectivityRevision = ++s_lastConnectivityRevision;
+}
+
+
+void SCH_SCREEN::SetConnectivityDirty()
+{
+    newConnectivityRevision();
+
+    if( m_itemIndexValid )
+    {
+        m_itemIndex.RemoveAll();
+        m_indexedItems.clear();
+        m_itemIndexValid = false;
+    }
+}
+
+
+void SCH_SCREEN::indexItem( SCH_ITEM* aItem ) const
+{
+    if( !m_itemIndexValid )
+        return;
+
+    EDA_RECT box = aItem->GetBoundingBox();
+
+    if( aItem->Type() == SCH_MARKER_T )
+    {
+        // HitTestMarker() rounds toward the marker position, it reaches a little past the box
+        box.Inflate( box.GetWidth() );
+    }
+    else if( aItem->Type() == SCH_SHEET_T )
+    {
+        for( const SCH_SHEET_PIN& pin : static_cast<SCH_SHEET*>( aItem )->GetPins() )
+            box.Merge( pin.GetBoundingBox() );
+    }
+
+    std::vector< wxPoint > points;
+    aItem->GetConnectionPoints( points );
+
+    for( const wxPoint& point : points )
+        box.Merge( point );
+
+    box.Normalize();
+
+    INDEXED_ITEM& entry = m_indexedItems[aItem];
+    entry.m_sequence = ++m_lastItemSequence;
+    entry.m_min[0] = box.GetX();
+    entry.m_min[1] = box.GetY();
+    entry.m_max[0] = box.GetRight();
+    entry.m_max[1] = box.GetBottom();
+
+    m_itemIndex.Insert( entry.m_min, entry.m_max, aItem );
+}
+
+
+void SCH_SCREEN::unindexItem( SCH_ITEM* aItem )
+{
+    if( !m_itemIndexValid )
+        return;
+
+    auto it = m_indexedItems.find( aItem );
+
+    if( it == m_indexedItems.end() )
+        return;
+
+    m_itemIndex.Remove( it->second.m_min, it->second.m_max, aItem );
+    m_indexedItems.erase( it );
+}
+
+
+void SCH_SCREEN::buildItemIndex() const
+{
+    m_itemIndex.RemoveAll();
+    m_indexedItems.clear();
+    m_lastItemSequence = 0;
+    m_itemIndexValid = true;
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+        indexItem( item );
+}
+
+
+std::vector<SCH_ITEM*> SCH_SCREEN::itemsNear( const wxPoint& aPosition, int aAccuracy ) const
+{
+    if( !m_itemIndexValid )
+        buildItemIndex();
+
+    std::vector<SCH_ITEM*> items;
+
+    // One more unit for the rounding of the segment distance tests
+    int margin = std::max( aAccuracy, 0 ) + 1;
+    const int min[2] = { aPosition.x - margin, aPosition.y - margin };
+    const int max[2] = { aPosition.x + margin, aPosition.y + margin };
+
+    auto visitor = [&items]( SCH_ITEM* aItem ) -> bool
+    {
+        items.push_back( aItem );
+        return true;
+    };
+
+    m_itemIndex.Search( min, max, visitor );
+
+    std::sort( items.begin(), items.end(),
+               [this]( const SCH_ITEM* aFirst, const SCH_ITEM* aSecond )
+               {
+                   return m_indexedItems.at( aFirst ).m_sequence
+                            < m_indexedItems.at( aSecond ).m_sequence;
+               } );
+
+    return items;
+}
+
+
 void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 {
     wxCHECK_RET( aScreen, "Invalid screen object." );
@@ -142,6 +265,7 @@ void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
     // No need to decend the hierarchy.  Once the top level screen is copied, all of it's
     // children are copied as well.
     m_drawList.Append( aScreen->m_drawList );
+    SetConnectivityDirty();
 
     // This screen owns the objects now.  This prevents the object from being delete when
     // aSheet is deleted.
@@ -163,12 +287,17 @@ void SCH_SCREEN::Clear()
 void SCH_SCREEN::FreeDrawList()
 {
     m_drawList.DeleteAll();
+    SetConnectivityDirty();
 }
 
 
 void SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
     m_drawList.Remove( aItem );
+    unindexItem( aItem );
+
+    if( aItem->Type() != SCH_MARKER_T )
+        newConnectivityRevision();
 }
 
 
@@ -176,7 +305,11 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
 {
     wxCHECK_RET( aItem, wxT( "Cannot delete invalid item from screen." ) );
 
-    SetModify();
+    // Markers are not connected to anything, removing them leaves the connectivity as is
+    if( aItem->Type() == SCH_MARKER_T )
+        BASE_SCREEN::SetModify();
+    else
+        SetModify();
 
     if( aItem->Type() == SCH_SHEET_PIN_T )
     {
@@ -190,6 +323,7 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
     }
     else
     {
+        unindexItem( aItem );
         delete m_drawList.Remove( aItem );
     }
 }
@@ -213,7 +347,7 @@ bool SCH_SCREEN::CheckIfOnDrawList( SCH_ITEM* aItem )
 
 SCH_ITEM* SCH_SCREEN::GetItem( const wxPoint& aPosition, int aAccuracy, KICAD_T aType ) const
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition, aAccuracy ) )
     {
         if( (aType == SCH_FIELD_T) && (item->Type() == SCH_COMPONENT_T) )
         {
@@ -272,6 +406,8 @@ void SCH_SCREEN::ExtractWires( DLIST< SCH_ITEM >& aList, bool aCreateCopy )
             break;
         }
     }
+
+    SetConnectivityDirty();
 }
 
 
@@ -298,6 +434,7 @@ void SCH_SCREEN::ReplaceWires( DLIST< SCH_ITEM >& aWireList )
     }
 
     m_drawList.Append( aWireList );
+    SetConnectivityDirty();
 }
 
 
@@ -351,7 +488,7 @@ bool SCH_SCREEN::IsJunctionNeeded( const wxPoint& aPosition, bool aNew )
 
     std::vector<SCH_LINE*> lines[2];
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition ) )
     {
         if( item->GetFlags() & STRUCT_DELETED )
             continue;
@@ -513,6 +650,7 @@ void SCH_SCREEN::UpdateSymbolLinks( bool aForce )
             SCH_COMPONENT::ResolveAll( c, *libs, Prj().SchLibs()->GetCacheLibrary() );
 
             m_modification_sync = mod_hash;     // note the last mod_hash
+            SetConnectivityDirty();             // the pins may have changed
         }
         // Resolving will update the pin caches but we must ensure that this happens
         // even if the libraries don't change.
@@ -589,11 +727,10 @@ void SCH_SCREEN::ClearDrawingState()
 LIB_PIN* SCH_SCREEN::GetPin( const wxPoint& aPosition, SCH_COMPONENT** aComponent,
                              bool aEndPointOnly ) const
 {
-    SCH_ITEM*       item;
     SCH_COMPONENT*  component = NULL;
     LIB_PIN*        pin = NULL;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition ) )
     {
         if( item->Type() != SCH_COMPONENT_T )
             continue;
@@ -663,7 +800,7 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 {
     SCH_SHEET_PIN* sheetPin = NULL;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition ) )
     {
         if( item->Type() != SCH_SHEET_T )
             continue;
@@ -681,10 +818,9 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 
 int SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions ) const
 {
-    SCH_ITEM* item;
     int       count = 0;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPos ) )
     {
         if( item->Type() == SCH_JUNCTION_T  && !aTestJunctions )
             continue;
@@ -705,6 +841,8 @@ void SCH_SCREEN::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
         {
             SCH_COMPONENT* component = (SCH_COMPONENT*) item;
 
+            SetAnnotationDirty();
+
             component->ClearAnnotation( aSheetPath );
 
             // Clear the modified component flag set by component->ClearAnnotation
@@ -933,7 +1071,7 @@ bool SCH_SCREEN::TestDanglingEnds()
 
 int SCH_SCREEN::GetNode( const wxPoint& aPosition, EDA_ITEMS& aList )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition ) )
     {
         if( item->Type() == SCH_LINE_T && item->HitTest( aPosition )
             && (item->GetLayer() == LAYER_BUS || item->GetLayer() == LAYER_WIRE) )
@@ -952,7 +1090,7 @@ int SCH_SCREEN::GetNode( const wxPoint& aPosition, EDA_ITEMS& aList )
 
 SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition ) )
     {
         if( (item->Type() == SCH_LINE_T) && item->HitTest( aPosition )
             && (item->GetLayer() == LAYER_BUS || item->GetLayer() == LAYER_WIRE) )
@@ -968,7 +1106,7 @@ SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition, aAccuracy ) )
     {
         if( item->Type() != SCH_LINE_T )
             continue;
@@ -1001,7 +1139,7 @@ SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLay
 
 SCH_TEXT* SCH_SCREEN::GetLabel( const wxPoint& aPosition, int aAccuracy )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    for( SCH_ITEM* item : itemsNear( aPosition, aAccuracy ) )
     {
         switch( item->Type() )
         {
@@ -1354,6 +1492,10 @@ int SCH_SCREENS::ReplaceDuplicateTimeStamps()
         {
             count++;
 
+            // The netlist items of the screens refer to the old time stamps and paths
+            for( size_t i = 0;  i < m_screens.size();  i++ )
+                m_screens[i]->SetAnnotationDirty();
+
             // for a component, update its Time stamp and its paths
             // (m_PathsAndReferences field)
             if( item->Type() == SCH_COMPONENT_T )
@@ -30,6 +30,9 @@
 #ifndef SCREEN_H
 #define SCREEN_H
 
+#include <unordered_map>
+#include <vector>
+
 #include <macros.h>
 #include <dlist.h>
 #include <sch_item_struct.h>
@@ -39,6 +42,7 @@
 #include <page_info.h>
 #include <kiway_player.h>
 #include <sch_marker.h>
+#include <geometry/rtree.h>
 
 #include <../eeschema/general.h>
 
@@ -86,6 +90,45 @@ private:
     int     m_modification_sync;        ///< inequality with PART_LIBS::GetModificationHash()
                                         ///< will trigger ResolveAll().
 
+    unsigned m_connectivityRevision;    ///< changed each time the items of the screen may
+                                        ///< be connected differently, see SetConnectivityDirty()
+
+    /// The position and the draw list order of an item of #m_itemIndex.
+    struct INDEXED_ITEM
+    {
+        unsigned m_sequence;
+        int      m_min[2];
+        int      m_max[2];
+    };
+
+    typedef RTree<SCH_ITEM*, int, 2, double> ITEM_RTREE;
+
+    /// The draw items by position, for the position lookups.  Built on the first lookup,
+    /// kept up to date by Append() and Remove(), and dropped by SetConnectivityDirty()
+    /// since the items may have been moved in place.
+    mutable ITEM_RTREE      m_itemIndex;
+    mutable bool            m_itemIndexValid;
+    mutable unsigned        m_lastItemSequence;
+    mutable std::unordered_map<const SCH_ITEM*, INDEXED_ITEM> m_indexedItems;
+
+    /// Give the screen a new connectivity revision, without dropping #m_itemIndex.
+    void newConnectivityRevision();
+
+    void buildItemIndex() const;
+
+    /// Add \a aItem, appended to the draw list, to #m_itemIndex if it is built.
+    void indexItem( SCH_ITEM* aItem ) const;
+
+    /// Remove \a aItem, removed from the draw list, from #m_itemIndex if it is built.
+    void unindexItem( SCH_ITEM* aItem );
+
+    /**
+     * Return the items which may be at \a aPosition, or at \a aAccuracy of it, in draw list
+     * order.  Their shape, fields, pins and connection points are within their bounding box
+     * grown by \a aAccuracy, the exact test is left to the caller.
+     */
+    std::vector<SCH_ITEM*> itemsNear( const wxPoint& aPosition, int aAccuracy = 0 ) const;
+
     /**
      * Add items connected at \a aPosition to the block pick list.
      * <p>
@@ -137,10 +180,42 @@ public:
      */
     SCH_ITEM* GetDrawItems() const                          { return m_drawList.begin(); }
 
+    /**
+     * Mark the screen as modified, and its items as possibly connected differently.
+     */
+    void SetModify() override
+    {
+        BASE_SCREEN::SetModify();
+        SetConnectivityDirty();
+    }
+
+    /**
+     * Tell the screen its items may be connected differently: an item was added, removed,
+     * moved or edited, or the library symbols were resolved again.
+     */
+    void SetConnectivityDirty();
+
+    /**
+     * Tell the screen the references or units of its components changed.  The items did not
+     * move, but the netlist read from the screen names its pins after them.
+     */
+    void SetAnnotationDirty() { newConnectivityRevision(); }
+
+    /**
+     * @return the connectivity revision of the screen.  It changes each time
+     *         SetConnectivityDirty() is called and two screens never share one, so the
+     *         connectivity read from a screen is up to date as long as its revision is.
+     */
+    unsigned GetConnectivityRevision() const { return m_connectivityRevision; }
+
     void Append( SCH_ITEM* aItem )
     {
         m_drawList.Append( aItem );
         --m_modification_sync;
+        indexItem( aItem );
+
+        if( aItem->Type() != SCH_MARKER_T )
+            newConnectivityRevision();
     }
 
     /**
@@ -164,6 +239,7 @@ public:
     {
         m_drawList.Append( aList );
         --m_modification_sync;
+        SetConnectivityDirty();
     }
 
     /**
@@ -321,7 +321,7 @@ public:
         }
     }
 
-    void SetModify()        { m_FlagModified = true; }
+    virtual void SetModify() { m_FlagModified = true; }
     void ClrModify()        { m_FlagModified = false; }
     void SetSave()          { m_FlagSave = true; }
     void ClrSave()          { m_FlagSave = false; }
@@ -389,6 +389,24 @@ public:
      */
     wxArrayString* ReadCommentLines();
 
+    /**
+     * Function ReadRawList
+     * copies the source text of the current list, without tokenizing it, and moves
+     * past the list: the next call to NextTok() returns the token following its
+     * closing parenthesis.  The current token must be the first one of the list,
+     * i.e. the keyword following the opening parenthesis.  Quoted strings and
+     * their escape sequences are honored as in the non-specctra mode.
+     *
+     * This is a cheap way to hand a whole list to another lexer, e.g. to parse it
+     * in a different thread.
+     *
+     * @param aText is appended the text of the list, from its opening parenthesis to
+     *  its closing parenthesis, so several lists can be gathered in one buffer.
+     *  Comment lines are omitted.
+     * @throw IO_ERROR if the end of input is reached before the end of the list.
+     */
+    void ReadRawList( std::string* aText );
+
     /**
      * Function IsSymbol
      * tests a token to see if it is a symbol.  This means it cannot be a
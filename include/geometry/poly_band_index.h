@@ -0,0 +1,72 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#ifndef __POLY_BAND_INDEX_H
+#define __POLY_BAND_INDEX_H
+
+#include <geometry/shape_line_chain.h>
+#include <math/box2.h>
+
+#include <vector>
+
+/**
+ * Class POLY_BAND_INDEX
+ *
+ * Provides a fast test for point inside a closed line chain, by sorting its edges into
+ * horizontal bands: a point only needs to be tested against the edges spanning its band.
+ * The test gives the same result as SHAPE_LINE_CHAIN::PointInside().
+ *
+ * The index does not keep a copy of the vertices: the chain it was built for must be
+ * passed to PointInside() and must not have changed since.
+ */
+class POLY_BAND_INDEX
+{
+public:
+    POLY_BAND_INDEX( const SHAPE_LINE_CHAIN& aPath );
+
+    /**
+     * Function PointInside()
+     *
+     * @param aPath the line chain the index was built for
+     * @param aP the point to check
+     * @return true if the point is inside aPath, as SHAPE_LINE_CHAIN::PointInside() would.
+     */
+    bool PointInside( const SHAPE_LINE_CHAIN& aPath, const VECTOR2I& aP ) const;
+
+    ///> Returns the number of bytes used by the index
+    size_t GetMemoryUsage() const
+    {
+        return sizeof( *this ) + m_bandStart.capacity() * sizeof( int )
+               + m_edges.capacity() * sizeof( int );
+    }
+
+private:
+    BOX2I m_bbox;
+    bool m_valid;                       ///< false for open or degenerate chains
+    int m_bandHeight;
+    std::vector<int> m_bandStart;       ///< band i holds m_edges[m_bandStart[i]..m_bandStart[i+1]]
+    std::vector<int> m_edges;
+};
+
+#endif // __POLY_BAND_INDEX_H
@@ -0,0 +1,64 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file seg_batch.h
+ * @brief Quick rejection of the segments of a polyline against a box, several segments
+ * at a time.
+ */
+
+#ifndef __SEG_BATCH_H
+#define __SEG_BATCH_H
+
+#include <math/vector2d.h>
+#include <math/box2.h>
+
+/**
+ * Function FindSegmentNearBox()
+ *
+ * Scans the segments (aPoints[i], aPoints[i + 1]) of a polyline, for aStart <= i < aSegmentCount,
+ * and returns the first one whose bounding box lies within aClearance of aBox along both axes.
+ * A segment that is skipped is farther than aClearance from anything inside aBox, so the scan
+ * only discards segments the exact collision tests would reject as well.
+ * Uses SSE2 or AVX2 when the CPU supports them.
+ *
+ * @param aPoints the polyline vertices (aSegmentCount + 1 of them)
+ * @param aStart the first segment to check
+ * @param aSegmentCount the number of segments of the polyline
+ * @param aBox the box to check against
+ * @param aClearance the distance from the box that still counts as near
+ * @return the index of the segment, or -1 if there is none.
+ */
+int FindSegmentNearBox( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                        const BOX2I& aBox, int aClearance );
+
+/**
+ * Function FindSegmentNearBoxScalar()
+ *
+ * Same as FindSegmentNearBox(), without SIMD instructions. Used as the fallback on the
+ * CPUs that have none, and as the reference for testing and benchmarking.
+ */
+int FindSegmentNearBoxScalar( const VECTOR2I* aPoints, int aStart, int aSegmentCount,
+                              const BOX2I& aBox, int aClearance );
+
+#endif // __SEG_BATCH_H
@@ -308,6 +308,19 @@ public:
      */
     bool Collide( const SEG& aSeg, int aClearance = 0 ) const override;
 
+    /**
+     * Function NextSegmentNear()
+     *
+     * Finds the first segment, starting from aStart, whose bounding box lies within aClearance
+     * of aBox. The segments skipped cannot collide with anything inside aBox, so this is a
+     * quick rejection step before the exact collision tests.
+     * @param aBox the box to check against
+     * @param aClearance the distance from the box that still counts as near
+     * @param aStart index of the first segment to check
+     * @return the segment index, or -1 if no further segment is that close.
+     */
+    int NextSegmentNear( const BOX2I& aBox, int aClearance, int aStart = 0 ) const;
+
     /**
      * Function Distance()
      *
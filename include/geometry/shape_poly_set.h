@@ -31,6 +31,7 @@
 #include <memory>
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
+#include <geometry/poly_band_index.h>
 
 #include "clipper.hpp"
 
@@ -571,6 +572,7 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aIndex-th outline in the set
         SHAPE_LINE_CHAIN& Outline( int aIndex )
         {
+            m_pointIndex.clear();
             return m_polys[aIndex][0];
         }
 
@@ -593,12 +595,14 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aHole-th hole in the aIndex-th outline
         SHAPE_LINE_CHAIN& Hole( int aOutline, int aHole )
         {
+            m_pointIndex.clear();
             return m_polys[aOutline][aHole + 1];
         }
 
         ///> Returns the aIndex-th subpolygon in the set
         POLYGON& Polygon( int aIndex )
         {
+            m_pointIndex.clear();
             return m_polys[aIndex];
         }
 
@@ -641,6 +645,8 @@ class SHAPE_POLY_SET : public SHAPE
         {
             ITERATOR iter;
 
+            m_pointIndex.clear();
+
             iter.m_poly = this;
             iter.m_currentPolygon = aFirst;
             iter.m_lastPolygon = aLast < 0 ? OutlineCount() - 1 : aLast;
@@ -850,6 +856,14 @@ class SHAPE_POLY_SET : public SHAPE
         ///> For aFastMode meaning, see function booleanOp
         void Simplify( POLYGON_MODE aFastMode );
 
+        ///> Same as Simplify(), for sets of thousands of polygons: the set is cut into
+        ///> horizontal bands which share no Y coordinate, and the bands are simplified on
+        ///> several threads. The result is identical to the one of Simplify(); a set which
+        ///> cannot be cut is simplified on the calling thread.
+        ///> For aFastMode meaning, see function booleanOp
+        ///> Returns the number of bands simplified, 1 when the set was not cut.
+        int SimplifyParallel( POLYGON_MODE aFastMode );
+
         /**
          * Function NormalizeAreaOutlines
          * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s)
@@ -956,6 +970,22 @@ class SHAPE_POLY_SET : public SHAPE
          */
         bool Contains( const VECTOR2I& aP, int aSubpolyIndex = -1, bool aIgnoreHoles = false ) const;
 
+        /**
+         * Function CachePointIndex
+         * Builds an index of the edges of each outline and hole, which Contains() uses until
+         * the set is modified, making it sublinear in the vertex count. Worth it for sets with
+         * many vertices which are tested many times, such as zone fills.
+         * Modifying the set through the SHAPE_POLY_SET methods drops the index; a point changed
+         * through a reference obtained before calling CachePointIndex() is not noticed.
+         */
+        void CachePointIndex();
+
+        ///> Returns true if Contains() uses the point index
+        bool HasPointIndex() const
+        {
+            return !m_pointIndex.empty();
+        }
+
         ///> Returns true if the set is empty (no polygons at all)
         bool IsEmpty() const
         {
@@ -1120,6 +1150,10 @@ class SHAPE_POLY_SET : public SHAPE
 
         bool pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN& aPath ) const;
 
+        ///> Tests aP against the aContour-th contour of the aPolygon-th polygon, using the
+        ///> point index if there is one
+        bool pointInContour( const VECTOR2I& aP, int aPolygon, int aContour ) const;
+
         const ClipperLib::Path convertToClipper( const SHAPE_LINE_CHAIN& aPath, bool aRequiredOrientation );
         const SHAPE_LINE_CHAIN convertFromClipper( const ClipperLib::Path& aPath );
 
@@ -1178,7 +1212,13 @@ class SHAPE_POLY_SET : public SHAPE
 
         SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
 
-        void CacheTriangulation();
+        /**
+         * Function CacheTriangulation
+         * builds the triangulation of all polygons, reusing unchanged ones.
+         * @param aParallel when false, all outlines are triangulated on the calling
+         * thread (use it when the caller already runs on a worker thread).
+         */
+        void CacheTriangulation( bool aParallel = true );
         bool IsTriangulationUpToDate() const;
 
         MD5_HASH GetHash() const;
@@ -1187,11 +1227,19 @@ class SHAPE_POLY_SET : public SHAPE
         void triangulateSingle( const POLYGON& aPoly, SHAPE_POLY_SET::TRIANGULATED_POLYGON& aResult );
 
         MD5_HASH checksum() const;
+        static MD5_HASH polygonChecksum( const POLYGON& aPoly );
 
+        ///> Triangulated polygons, kept after the set changes so that CacheTriangulation()
+        ///> can reuse the ones whose polygon did not change
         std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
+        std::vector<MD5_HASH> m_triangulatedHashes;     ///< checksums of their polygons
         bool m_triangulationValid = false;
         MD5_HASH m_hash;
 
+        ///> Point in polygon index, one entry per contour of each polygon. Empty when not
+        ///> built or out of date.
+        std::vector<std::vector<POLY_BAND_INDEX>> m_pointIndex;
+
 };
 
 #endif
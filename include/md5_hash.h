@@ -29,6 +29,9 @@ public:
     bool operator==( const MD5_HASH& aOther ) const;
     bool operator!=( const MD5_HASH& aOther ) const;
 
+    ///> Arbitrary strict ordering, for use as a key in sorted containers
+    bool operator<( const MD5_HASH& aOther ) const;
+
 private:
     struct MD5_CTX {
        uint8_t data[64];
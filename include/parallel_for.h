@@ -0,0 +1,74 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file parallel_for.h
+ * @brief Runs the iterations of a loop on worker threads.
+ */
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * Function ParallelFor
+ * runs aJob( i ) for 0 <= i < aCount, on as many threads as the CPU has cores (at least
+ * two), each thread taking the next index not taken yet.  Runs the jobs on the calling
+ * thread when there are fewer than two of them.
+ * The jobs must not depend on each other, nor on the order they run in.
+ */
+inline void ParallelFor( size_t aCount, const std::function<void( size_t )>& aJob )
+{
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ), aCount );
+
+    if( parallelThreadCount < 2 )
+    {
+        for( size_t i = 0; i < aCount; i++ )
+            aJob( i );
+
+        return;
+    }
+
+    std::atomic<size_t> next( 0 );
+    std::vector<std::thread> workers;
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        workers.push_back( std::thread( [&aCount, &aJob, &next]()
+        {
+            for( size_t i = next.fetch_add( 1 ); i < aCount; i = next.fetch_add( 1 ) )
+                aJob( i );
+        } ) );
+    }
+
+    for( std::thread& worker : workers )
+        worker.join();
+}
+
+#endif // PARALLEL_FOR_H
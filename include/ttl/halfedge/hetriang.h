@@ -45,6 +45,7 @@
 #define TTL_USE_NODE_ID   // Each node gets it's own unique id
 #define TTL_USE_NODE_FLAG // Each node gets a flag (can be set to true or false)
 
+#include <atomic>
 #include <list>
 #include <unordered_set>
 #include <vector>
@@ -95,8 +96,9 @@ protected:
 #endif
 
 #ifdef TTL_USE_NODE_ID
-    /// TTL_USE_NODE_ID must be defined
-    static int id_count;
+    /// TTL_USE_NODE_ID must be defined.  Atomic, since the nets are triangulated
+    /// on several threads
+    static std::atomic<int> id_count;
 
     /// A unique id for each node (TTL_USE_NODE_ID must be defined)
     int m_id;
@@ -31,6 +31,7 @@
 #include <board_commit.h>
 #include <tools/pcb_tool.h>
 #include <connectivity_data.h>
+#include <drc.h>
 
 #include <functional>
 using namespace std::placeholders;
@@ -65,6 +66,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     PCB_BASE_FRAME* frame = (PCB_BASE_FRAME*) m_toolMgr->GetEditFrame();
     auto connectivity = board->GetConnectivity();
     std::set<EDA_ITEM*> savedModules;
+    std::vector<EDA_RECT> dirtyAreas;
+    EDA_RECT dirtyArea;
+    bool dirty = false;
 
     if( Empty() )
         return;
@@ -75,6 +79,28 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
         int changeFlags = ent.m_type & CHT_FLAGS;
         BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
 
+        // Gather the areas touched by the changes, for the incremental DRC
+        // and zone refill.  Markers are skipped, as they are the DRC output.
+        if( !m_editModules && boardItem->Type() != PCB_MARKER_T )
+        {
+            EDA_RECT bbox = boardItem->GetBoundingBox();
+
+            dirtyAreas.push_back( bbox );
+
+            if( ent.m_copy )
+            {
+                dirtyAreas.push_back( ent.m_copy->GetBoundingBox() );
+                bbox.Merge( dirtyAreas.back() );
+            }
+
+            if( dirty )
+                dirtyArea.Merge( bbox );
+            else
+                dirtyArea = bbox;
+
+            dirty = true;
+        }
+
         // Module items need to be saved in the undo buffer before modification
         if( m_editModules )
         {
@@ -283,8 +309,22 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
         panel->RedrawRatsnest();
     }
 
+    if( dirty && frame->IsType( FRAME_PCB ) )
+    {
+        DRC* drc = static_cast<PCB_EDIT_FRAME*>( frame )->GetDrcController();
+
+        if( drc && drc->IsIncrementalMode() )
+            drc->RunIncrementalTests( dirtyAreas );
+    }
+
     if( aSetDirtyBit )
+    {
+        // Let the next zone fill be limited to the changed area
+        if( dirty && frame->IsType( FRAME_PCB ) )
+            static_cast<PCB_EDIT_FRAME*>( frame )->AddZoneFillsDirtyArea( dirtyArea );
+
         frame->OnModify();
+    }
 
     frame->UpdateMsgPanel();
 
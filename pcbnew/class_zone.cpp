@@ -91,6 +91,7 @@ ZONE_CONTAINER::ZONE_CONTAINER( const ZONE_CONTAINER& aZone ) :
     m_ThermalReliefGap = aZone.m_ThermalReliefGap;
     m_ThermalReliefCopperBridge = aZone.m_ThermalReliefCopperBridge;
     m_FilledPolysList.Append( aZone.m_FilledPolysList );
+    m_RawPolysList = aZone.m_RawPolysList;
     m_FillSegmList = aZone.m_FillSegmList;      // vector <> copy
 
     m_isKeepout = aZone.m_isKeepout;
@@ -131,6 +132,7 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
     m_FilledPolysList.RemoveAllContours();
     m_FilledPolysList.Append( aOther.m_FilledPolysList );
+    m_RawPolysList = aOther.m_RawPolysList;
     m_FillSegmList.clear();
     m_FillSegmList = aOther.m_FillSegmList;
 
@@ -1279,9 +1281,10 @@ void ZONE_CONTAINER::SwapData( BOARD_ITEM* aImage )
 }
 
 
-void ZONE_CONTAINER::CacheTriangulation()
+void ZONE_CONTAINER::CacheTriangulation( bool aParallel )
 {
-    m_FilledPolysList.CacheTriangulation();
+    m_FilledPolysList.CacheTriangulation( aParallel );
+    m_FilledPolysList.CachePointIndex();
 }
 
 
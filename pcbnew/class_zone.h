@@ -536,7 +536,7 @@ public:
         return m_FilledPolysList;
     }
 
-    void CacheTriangulation();
+    void CacheTriangulation( bool aParallel = true );
 
    /**
      * Function SetFilledPolysList
@@ -590,6 +590,14 @@ public:
         return m_RawPolysList;
     }
 
+    /**
+     * @return the filled areas before removal of the insulated copper islands.
+     */
+    const SHAPE_POLY_SET& GetRawPolysList() const
+    {
+        return m_RawPolysList;
+    }
+
     wxString GetSelectMenuText( EDA_UNITS_T aUnits ) const override;
 
     BITMAP_DEF GetMenuImage() const override;
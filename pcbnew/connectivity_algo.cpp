@@ -318,6 +318,9 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     m_itemList.RemoveInvalidItems( garbage );
     m_zoneList.RemoveInvalidItems( garbage );
 
+    if( !garbage.empty() )
+        invalidateClusters();
+
     for( auto item : garbage )
         delete item;
 
@@ -466,8 +469,27 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 }
 
 
+void CN_CONNECTIVITY_ALGO::invalidateClusters()
+{
+    for( const auto& cluster : m_ratsnestClusters )
+    {
+        if( IsNetDirty( cluster->OriginNet() ) )
+            continue;
+
+        for( auto item : *cluster )
+        {
+            if( !item->Valid() )
+            {
+                MarkNetAsDirty( cluster->OriginNet() );
+                break;
+            }
+        }
+    }
+}
+
+
 const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
-        const KICAD_T aTypes[], int aSingleNet )
+        const KICAD_T aTypes[], int aSingleNet, bool aDirtyNetsOnly )
 {
     bool includeZones = ( aMode != CSM_PROPAGATE );
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
@@ -476,10 +498,14 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
     CN_ITEM* head = nullptr;
     CLUSTERS clusters;
 
+    // Items the incremental search starts from
+    std::vector<CN_ITEM*> roots;
+
     if( isDirty() )
         searchConnections();
 
-    auto addToSearchList = [&head, withinAnyNet, aSingleNet, aTypes] ( CN_ITEM *aItem )
+    auto addToSearchList = [this, &head, &roots, withinAnyNet, aSingleNet, aTypes,
+                            aDirtyNetsOnly] ( CN_ITEM *aItem )
     {
         if( withinAnyNet && aItem->Net() <= 0 )
             return;
@@ -511,6 +537,9 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
             head = aItem;
         else
             head->ListInsert( aItem );
+
+        if( aDirtyNetsOnly && IsNetDirty( aItem->Net() ) )
+            roots.push_back( aItem );
     };
 
     std::for_each( m_itemList.begin(), m_itemList.end(), addToSearchList );
@@ -521,12 +550,30 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
     }
 
 
-    while( head )
+    auto nextRoot = [&head, &roots, aDirtyNetsOnly] () -> CN_ITEM*
+    {
+        if( !aDirtyNetsOnly )
+            return head;
+
+        // Clusters without any dirty item are left untouched.  The other items stay
+        // in the search list, so the clusters can still grow through them.
+        while( !roots.empty() )
+        {
+            CN_ITEM* root = roots.back();
+            roots.pop_back();
+
+            if( !root->Visited() )
+                return root;
+        }
+
+        return nullptr;
+    };
+
+    while( CN_ITEM* root = nextRoot() )
     {
         CN_CLUSTER_PTR cluster ( new CN_CLUSTER() );
 
         Q.clear();
-        CN_ITEM* root = head;
         root->SetVisited ( true );
 
         head = root->ListRemove();
@@ -678,7 +725,10 @@ void CN_CONNECTIVITY_ALGO::propagateConnections()
 
 void CN_CONNECTIVITY_ALGO::PropagateNets()
 {
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+    constexpr KICAD_T types[] = { PCB_TRACE_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_AREA_T, PCB_MODULE_T, EOT };
+
+    // Items not connected to a changed net keep the net they got from the last pass
+    m_connClusters = SearchClusters( CSM_PROPAGATE, types, -1, true );
     propagateConnections();
 }
 
@@ -749,7 +799,25 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLAT
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    constexpr KICAD_T types[] = { PCB_TRACE_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_AREA_T, PCB_MODULE_T, EOT };
+
+    // Ratsnest clusters never span several nets, so only the dirty nets need a new search
+    CLUSTERS dirtyClusters = SearchClusters( CSM_RATSNEST, types, -1, true );
+
+    m_ratsnestClusters.erase( std::remove_if( m_ratsnestClusters.begin(), m_ratsnestClusters.end(),
+            [this] ( const CN_CLUSTER_PTR& aCluster )
+            {
+                return IsNetDirty( aCluster->OriginNet() );
+            } ), m_ratsnestClusters.end() );
+
+    m_ratsnestClusters.insert( m_ratsnestClusters.end(), dirtyClusters.begin(), dirtyClusters.end() );
+
+    std::stable_sort( m_ratsnestClusters.begin(), m_ratsnestClusters.end(),
+            []( const CN_CLUSTER_PTR& a, const CN_CLUSTER_PTR& b )
+            {
+                return a->OriginNet() < b->OriginNet();
+            } );
+
     return m_ratsnestClusters;
 }
 
@@ -112,12 +112,12 @@ public:
         return m_noline;
     }
 
-    inline void SetCluster( std::shared_ptr<CN_CLUSTER> aCluster )
+    inline void SetCluster( CN_CLUSTER* aCluster )
     {
         m_cluster = aCluster;
     }
 
-    inline std::shared_ptr<CN_CLUSTER> GetCluster() const
+    inline CN_CLUSTER* GetCluster() const
     {
         return m_cluster;
     }
@@ -148,8 +148,8 @@ private:
     /// Whether it the node can be a target for ratsnest lines
     bool m_noline = false;
 
-    /// Cluster to which the anchor belongs
-    std::shared_ptr<CN_CLUSTER> m_cluster;
+    /// Cluster to which the anchor belongs (owned by the RN_NET of the cluster net)
+    CN_CLUSTER* m_cluster = nullptr;
 };
 
 
@@ -301,14 +301,14 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
-        m_anchors.reserve( 2 );
+        m_anchors.reserve( aAnchorCount );
     }
 
     virtual ~CN_ITEM() {};
 
     void AddAnchor( const VECTOR2I& aPos )
     {
-        m_anchors.emplace_back( std::make_unique<CN_ANCHOR>( aPos, this ) );
+        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
     }
 
     CN_ANCHORS& Anchors()
@@ -458,6 +458,11 @@ public:
     template <class T>
     void FindNearby( CN_ITEM *aItem, T aFunc );
 
+    ///> Calls aFunc for each item whose bounding box intersects aBBox, including the
+    ///> items which are no longer valid
+    template <class T>
+    void FindNearby( const BOX2I& aBBox, T aFunc );
+
     void SetHasInvalid( bool aInvalid = true )
     {
         m_hasInvalid = aInvalid;
@@ -498,7 +503,7 @@ public:
 
     CN_ITEM* Add( D_PAD* pad )
     {
-        auto item = new CN_ITEM( pad, false, 2 );
+        auto item = new CN_ITEM( pad, false, 1 );
         item->AddAnchor( pad->ShapePos() );
         addItemtoTree( item );
         m_items.push_back( item );
@@ -519,7 +524,7 @@ public:
 
     CN_ITEM* Add( VIA* via )
     {
-        auto item = new CN_ITEM( via, true );
+        auto item = new CN_ITEM( via, true, 1 );
 
         m_items.push_back( item );
         item->AddAnchor( via->GetStart() );
@@ -534,7 +539,7 @@ class CN_ZONE : public CN_ITEM
 {
 public:
     CN_ZONE( ZONE_CONTAINER* aParent, bool aCanChangeNet, int aSubpolyIndex ) :
-        CN_ITEM( aParent, aCanChangeNet ),
+        CN_ITEM( aParent, aCanChangeNet, 1 ),
         m_subpolyIndex( aSubpolyIndex )
     {
         SHAPE_LINE_CHAIN outline = aParent->GetFilledPolysList().COutline( aSubpolyIndex );
@@ -595,8 +600,10 @@ public:
             CN_ZONE* zitem = new CN_ZONE( zone, false, j );
             const auto& outline = zone->GetFilledPolysList().COutline( j );
 
-            for( int k = 0; k < outline.PointCount(); k++ )
-                zitem->AddAnchor( outline.CPoint( k ) );
+            // The ratsnest only uses one anchor for a zone: do not waste an anchor
+            // for every vertex of the filled area
+            if( outline.PointCount() )
+                zitem->AddAnchor( outline.CPoint( 0 ) );
 
             m_items.push_back( zitem );
             addItemtoTree( zitem );
@@ -635,6 +642,12 @@ void CN_LIST::FindNearby( CN_ITEM *aItem, T aFunc )
     m_index.Query( aItem->BBox(), aFunc );
 }
 
+template <class T>
+void CN_LIST::FindNearby( const BOX2I& aBBox, T aFunc )
+{
+    m_index.Query( aBBox, aFunc );
+}
+
 class CN_CONNECTIVITY_ALGO
 {
 public:
@@ -671,7 +684,7 @@ public:
             m_items.push_back( aItem );
         }
 
-        const std::list<CN_ITEM*> GetItems() const
+        const std::list<CN_ITEM*>& GetItems() const
         {
             return m_items;
         }
@@ -694,6 +707,13 @@ public:
 
     void    searchConnections();
 
+    /**
+     * Marks as dirty the nets of the cached ratsnest clusters referring to items
+     * about to be deleted, so they are rebuilt even if the net of the removed item
+     * changed before its removal.
+     */
+    void    invalidateClusters();
+
     void    update();
     void    propagateConnections();
 
@@ -727,7 +747,7 @@ public:
 
     bool IsNetDirty( int aNet ) const
     {
-        if( aNet < 0 )
+        if( aNet < 0 || aNet >= (int) m_dirtyNets.size() )
             return false;
 
         return m_dirtyNets[ aNet ];
@@ -763,7 +783,15 @@ public:
     bool    Remove( BOARD_ITEM* aItem );
     bool    Add( BOARD_ITEM* aItem );
 
-    const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode, const KICAD_T aTypes[], int aSingleNet );
+    /**
+     * Function SearchClusters
+     * groups the connected items in clusters.
+     * @param aDirtyNetsOnly restricts the search to the clusters having at least one
+     * item on a net marked as dirty (the other clusters are unchanged since the last
+     * search). In CSM_PROPAGATE mode, these clusters can also contain items of clean nets.
+     */
+    const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode, const KICAD_T aTypes[],
+                                    int aSingleNet, bool aDirtyNetsOnly = false );
     const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
     void    PropagateNets();
@@ -28,10 +28,9 @@
 #include <connectivity_data.h>
 #include <connectivity_algo.h>
 #include <ratsnest_data.h>
+#include <parallel_for.h>
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif /* USE_OPENMP */
+#include <algorithm>
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA()
 {
@@ -87,37 +86,42 @@ void CONNECTIVITY_DATA::Build( const std::vector<BOARD_ITEM*>& aItems )
 
 void CONNECTIVITY_DATA::updateRatsnest()
 {
-    int lastNet = m_connAlgo->NetCount();
-
     #ifdef PROFILE
     PROF_COUNTER rnUpdate( "update-ratsnest" );
     #endif
 
-    int nDirty = 0;
-
-    int i;
+    int lastNet = m_connAlgo->NetCount();
+    std::vector<RN_NET*> dirty_nets;
 
-    #ifdef USE_OPENMP
-        #pragma omp parallel shared(lastNet) private(i)
+    // Start with net number 1, as 0 stands for not connected
+    for( int i = 1; i < lastNet; ++i )
     {
-        #pragma omp for schedule(guided, 1)
-    #else /* USE_OPENMP */
-    {
-    #endif
+        if( m_nets[i]->IsDirty() )
+            dirty_nets.push_back( m_nets[i] );
+    }
 
-        // Start with net number 1, as 0 stands for not connected
-        for( i = 1; i < lastNet; ++i )
-        {
-            if( m_nets[i]->IsDirty() )
+    // The triangulation cost grows faster than the node count: start with the biggest
+    // nets, so a large net picked up last does not keep a single thread busy
+    std::sort( dirty_nets.begin(), dirty_nets.end(),
+            []( const RN_NET* a, const RN_NET* b )
             {
-                m_nets[i]->Update();
-                nDirty++;
-            }
-        }
-    }          /* end of parallel section */
+                return a->GetNodeCount() > b->GetNodeCount();
+            } );
+
+    ParallelFor( dirty_nets.size(), [&dirty_nets]( size_t i )
+            {
+                dirty_nets[i]->Update();
+            } );
 
     #ifdef PROFILE
     rnUpdate.Show();
+
+    for( auto net : dirty_nets )
+    {
+        if( net->GetUpdateTime() > 1.0 )
+            wxLogTrace( "RATSNEST", "net with %u nodes took %.1f ms",
+                        net->GetNodeCount(), net->GetUpdateTime() );
+    }
     #endif /* PROFILE */
 }
 
@@ -199,7 +203,7 @@ void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aIte
 
             for( auto cnItem : entry.GetItems() )
             {
-                for( auto anchor : cnItem->Anchors() )
+                for( const auto& anchor : cnItem->Anchors() )
                     anchor->SetNoLine( true );
             }
         }
@@ -560,7 +564,7 @@ const std::vector<VECTOR2I> CONNECTIVITY_DATA::NearestUnconnectedTargets(
                 if( item->Valid() && item->Parent()->GetNetCode() == refNet
                     && item->Parent()->Type() != PCB_ZONE_AREA_T )
                 {
-                    for( auto anchor : item->Anchors() )
+                    for( const auto& anchor : item->Anchors() )
                     {
                         anchors.insert( anchor->Pos() );
                     }
@@ -608,7 +612,7 @@ const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetConnectedItems(
 
     for( auto cnItem : entry.GetItems() )
     {
-        for( auto anchor : cnItem->Anchors() )
+        for( const auto& anchor : cnItem->Anchors() )
         {
             if( anchor->Pos() == aAnchor )
             {
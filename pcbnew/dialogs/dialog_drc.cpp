@@ -185,6 +185,7 @@ void DIALOG_DRC_CONTROL::InitValues()
     bool value;
     m_config->Read( RefillZonesBeforeDrc, &value, false );
     m_cbRefillZones->SetValue( value );
+    m_cbIncrementalDrc->SetValue( m_tester->IsIncrementalMode() );
 
     Layout();      // adding the units above expanded Clearance text, now resize.
 
@@ -381,6 +382,13 @@ void DIALOG_DRC_CONTROL::OnCancelClick( wxCommandEvent& event )
 }
 
 
+void DIALOG_DRC_CONTROL::OnIncrementalDrcClicked( wxCommandEvent& event )
+{
+    // Takes effect with the next edit, and is kept for the next sessions
+    m_tester->SetIncrementalMode( m_cbIncrementalDrc->IsChecked() );
+}
+
+
 void DIALOG_DRC_CONTROL::OnReportCheckBoxClicked( wxCommandEvent& event )
 {
     if( m_CreateRptCtrl->IsChecked() )
@@ -94,6 +94,9 @@ private:
 
     void SetDrcParmeters( );
 
+    /// wxEVT_COMMAND_CHECKBOX_CLICKED event handler for m_cbIncrementalDrc
+    void OnIncrementalDrcClicked( wxCommandEvent& event ) override;
+
     /// wxEVT_COMMAND_CHECKBOX_CLICKED event handler for ID_CHECKBOX_RPT_FILE
     void OnReportCheckBoxClicked( wxCommandEvent& event ) override;
 
@@ -60,6 +60,7 @@ class DIALOG_DRC_CONTROL_BASE : public DIALOG_SHIM
 		wxStaticText* m_MicroViaMinUnit;
 		wxCheckBox* m_cbRefillZones;
 		wxCheckBox* m_cbReportAllTrackErrors;
+		wxCheckBox* m_cbIncrementalDrc;
 		wxStaticText* m_messagesLabel;
 		wxTextCtrl* m_Messages;
 		wxCheckBox* m_CreateRptCtrl;
@@ -77,6 +78,7 @@ class DIALOG_DRC_CONTROL_BASE : public DIALOG_SHIM
 		
 		// Virtual event handlers, overide them in your derived class
 		virtual void OnActivateDlg( wxActivateEvent& event ) { event.Skip(); }
+		virtual void OnIncrementalDrcClicked( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnReportCheckBoxClicked( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnReportFilenameEdited( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnButtonBrowseRptFileClick( wxCommandEvent& event ) { event.Skip(); }
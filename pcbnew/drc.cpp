@@ -28,6 +28,7 @@
  */
 
 #include <fctsys.h>
+#include <kiface_i.h>
 #include <pcb_edit_frame.h>
 #include <trigo.h>
 #include <base_units.h>
@@ -55,6 +56,13 @@
 #include <dialog_drc.h>
 #include <wx/progdlg.h>
 #include <board_commit.h>
+#include <geometry/rtree.h>
+#include <profile.h>
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <functional>
 
 void DRC::ShowDRCDialog( wxWindow* aParent )
 {
@@ -107,13 +115,35 @@ void DRC::addMarkerToPcb( MARKER_PCB* aMarker )
     }
     else
     {
-        BOARD_COMMIT commit( m_pcbEditorFrame );
-        commit.Add( aMarker );
-        commit.Push( wxEmptyString, false, false );
+        std::vector<MARKER_PCB*> markers = { aMarker };
+        addMarkersToPcb( markers );
     }
 }
 
 
+void DRC::addMarkersToPcb( const std::vector<MARKER_PCB*>& aMarkers )
+{
+    if( aMarkers.empty() )
+        return;
+
+    // Without editor frame (batch mode), there is no view and no undo list to update
+    if( !m_pcbEditorFrame )
+    {
+        for( MARKER_PCB* marker : aMarkers )
+            m_pcb->Add( marker );
+
+        return;
+    }
+
+    BOARD_COMMIT commit( m_pcbEditorFrame );
+
+    for( MARKER_PCB* marker : aMarkers )
+        commit.Add( marker );
+
+    commit.Push( wxEmptyString, false, false );
+}
+
+
 void DRC::DestroyDRCDialog( int aReason )
 {
     if( m_drcDialog )
@@ -126,13 +156,59 @@ void DRC::DestroyDRCDialog( int aReason )
 }
 
 
+// Config key of the incremental tests option
+#define DrcAfterEachEdit    wxT( "DrcAfterEachEdit" )
+
+
+struct DRC::SMOOTHED_ZONE
+{
+    SHAPE_POLY_SET  m_outline;          ///< the outline the smoothed one was built from
+    int             m_smoothingType;
+    unsigned int    m_cornerRadius;
+    int             m_arcSegmentCount;
+    SHAPE_POLY_SET  m_smoothedPoly;
+};
+
+
 DRC::DRC( PCB_EDIT_FRAME* aPcbWindow )
 {
     m_pcbEditorFrame = aPcbWindow;
     m_pcb = aPcbWindow->GetBoard();
-    m_drcDialog  = NULL;
     m_units = aPcbWindow->GetUserUnits();
 
+    init();
+
+    if( wxConfigBase* config = Kiface().KifaceSettings() )
+        config->Read( DrcAfterEachEdit, &m_doIncrementalTest, false );
+}
+
+
+DRC::DRC( BOARD* aBoard, EDA_UNITS_T aUnits )
+{
+    m_pcbEditorFrame = nullptr;
+    m_pcb = aBoard;
+    m_units = aUnits;
+
+    init();
+}
+
+
+void DRC::SetIncrementalMode( bool aEnable )
+{
+    m_doIncrementalTest = aEnable;
+
+    if( !m_pcbEditorFrame )
+        return;
+
+    if( wxConfigBase* config = Kiface().KifaceSettings() )
+        config->Write( DrcAfterEachEdit, aEnable );
+}
+
+
+void DRC::init()
+{
+    m_drcDialog  = NULL;
+
     // establish initial values for everything:
     m_drcInLegacyRoutingMode = false;
     m_doPad2PadTest     = true;     // enable pad to pad clearance tests
@@ -141,11 +217,13 @@ DRC::DRC( PCB_EDIT_FRAME* aPcbWindow )
     m_doKeepoutTest = true;         // enable keepout areas to items clearance tests
     m_refillZones = false;            // Only fill zones if requested by user.
     m_reportAllTrackErrors = false;
+    m_doIncrementalTest = false;    // Incremental tests after each edit are run only on request
     m_doCreateRptFile = false;
 
     // m_rptFilename set to empty by its constructor
 
     m_currentMarker = NULL;
+    m_incrementalTestCount = 0;
 
     m_segmAngle  = 0;
     m_segmLength = 0;
@@ -205,18 +283,23 @@ int DRC::DrcOnCreatingTrack( TRACK* aRefSegm, TRACK* aList )
 
 int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
 {
-    BOARD* board = m_pcbEditorFrame->GetBoard();
-    EDA_UNITS_T units = m_pcbEditorFrame->GetUserUnits();
-    BOARD_COMMIT commit( m_pcbEditorFrame );
+    BOARD* board = m_pcbEditorFrame ? m_pcbEditorFrame->GetBoard() : m_pcb;
+    std::vector<MARKER_PCB*> markers;
     int nerrors = 0;
 
+    std::vector<SHAPE_POLY_SET> smoothedPolys( board->GetAreaCount() );
+
+    // Each outline is tested against the corners of all the others
+    for( int ia = 0; ia < board->GetAreaCount(); ia++ )
+    {
+        board->GetArea( ia )->BuildSmoothedPoly( smoothedPolys[ia] );
+        smoothedPolys[ia].CachePointIndex();
+    }
+
     // iterate through all areas
     for( int ia = 0; ia < board->GetAreaCount(); ia++ )
     {
         ZONE_CONTAINER* zoneRef = board->GetArea( ia );
-        SHAPE_POLY_SET refSmoothedPoly;
-
-        zoneRef->BuildSmoothedPoly( refSmoothedPoly );
 
         if( !zoneRef->IsOnCopperLayer() )
             continue;
@@ -227,134 +310,140 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
 
         for( int ia2 = 0; ia2 < board->GetAreaCount(); ia2++ )
         {
-            ZONE_CONTAINER* zoneToTest = board->GetArea( ia2 );
-            SHAPE_POLY_SET testSmoothedPoly;
+            nerrors += doZoneToZoneDrc( zoneRef, smoothedPolys[ia],
+                                        board->GetArea( ia2 ), smoothedPolys[ia2],
+                                        aCreateMarkers ? &markers : nullptr );
+        }
+    }
 
-            zoneToTest->BuildSmoothedPoly( testSmoothedPoly );
+    addMarkersToPcb( markers );
 
-            if( zoneRef == zoneToTest )
-                continue;
+    return nerrors;
+}
 
-            // test for same layer
-            if( zoneRef->GetLayer() != zoneToTest->GetLayer() )
-                continue;
 
-            // Test for same net
-            if( zoneRef->GetNetCode() == zoneToTest->GetNetCode() && zoneRef->GetNetCode() >= 0 )
-                continue;
+int DRC::doZoneToZoneDrc( ZONE_CONTAINER* zoneRef, SHAPE_POLY_SET& refSmoothedPoly,
+                          ZONE_CONTAINER* zoneToTest, SHAPE_POLY_SET& testSmoothedPoly,
+                          std::vector<MARKER_PCB*>* aMarkers )
+{
+    EDA_UNITS_T units = m_units;
+    int nerrors = 0;
 
-            // test for different priorities
-            if( zoneRef->GetPriority() != zoneToTest->GetPriority() )
-                continue;
+    if( zoneRef == zoneToTest )
+        return 0;
 
-            // test for different types
-            if( zoneRef->GetIsKeepout() != zoneToTest->GetIsKeepout() )
-                continue;
+    // test for same layer
+    if( zoneRef->GetLayer() != zoneToTest->GetLayer() )
+        return 0;
 
-            // Examine a candidate zone: compare zoneToTest to zoneRef
+    // Test for same net
+    if( zoneRef->GetNetCode() == zoneToTest->GetNetCode() && zoneRef->GetNetCode() >= 0 )
+        return 0;
 
-            // Get clearance used in zone to zone test.  The policy used to
-            // obtain that value is now part of the zone object itself by way of
-            // ZONE_CONTAINER::GetClearance().
-            int zone2zoneClearance = zoneRef->GetClearance( zoneToTest );
+    // test for different priorities
+    if( zoneRef->GetPriority() != zoneToTest->GetPriority() )
+        return 0;
 
-            // Keepout areas have no clearance, so set zone2zoneClearance to 1
-            // ( zone2zoneClearance = 0  can create problems in test functions)
-            if( zoneRef->GetIsKeepout() )
-                zone2zoneClearance = 1;
+    // test for different types
+    if( zoneRef->GetIsKeepout() != zoneToTest->GetIsKeepout() )
+        return 0;
 
-            // test for some corners of zoneRef inside zoneToTest
-            for( auto iterator = refSmoothedPoly.IterateWithHoles(); iterator; iterator++ )
-            {
-                VECTOR2I currentVertex = *iterator;
+    // Examine a candidate zone: compare zoneToTest to zoneRef
 
-                if( testSmoothedPoly.Contains( currentVertex ) )
-                {
-                    // COPPERAREA_COPPERAREA error: copper area ref corner inside copper area
-                    if( aCreateMarkers )
-                    {
-                        wxPoint pt( currentVertex.x, currentVertex.y );
-                        auto marker = new MARKER_PCB( units, COPPERAREA_INSIDE_COPPERAREA,
-                                                      pt, zoneRef, pt, zoneToTest, pt );
-                        commit.Add( marker );
-                    }
+    // Get clearance used in zone to zone test.  The policy used to
+    // obtain that value is now part of the zone object itself by way of
+    // ZONE_CONTAINER::GetClearance().
+    int zone2zoneClearance = zoneRef->GetClearance( zoneToTest );
 
-                    nerrors++;
-                }
-            }
+    // Keepout areas have no clearance, so set zone2zoneClearance to 1
+    // ( zone2zoneClearance = 0  can create problems in test functions)
+    if( zoneRef->GetIsKeepout() )
+        zone2zoneClearance = 1;
+
+    // test for some corners of zoneRef inside zoneToTest
+    for( auto iterator = refSmoothedPoly.CIterateWithHoles(); iterator; iterator++ )
+    {
+        VECTOR2I currentVertex = *iterator;
 
-            // test for some corners of zoneToTest inside zoneRef
-            for( auto iterator = testSmoothedPoly.IterateWithHoles(); iterator; iterator++ )
+        if( testSmoothedPoly.Contains( currentVertex ) )
+        {
+            // COPPERAREA_COPPERAREA error: copper area ref corner inside copper area
+            if( aMarkers )
             {
-                VECTOR2I currentVertex = *iterator;
+                wxPoint pt( currentVertex.x, currentVertex.y );
+                aMarkers->push_back( new MARKER_PCB( units, COPPERAREA_INSIDE_COPPERAREA,
+                                                     pt, zoneRef, pt, zoneToTest, pt ) );
+            }
 
-                if( refSmoothedPoly.Contains( currentVertex ) )
-                {
-                    // COPPERAREA_COPPERAREA error: copper area corner inside copper area ref
-                    if( aCreateMarkers )
-                    {
-                        wxPoint pt( currentVertex.x, currentVertex.y );
-                        auto marker = new MARKER_PCB( units, COPPERAREA_INSIDE_COPPERAREA,
-                                                      pt, zoneToTest, pt, zoneRef, pt );
-                        commit.Add( marker );
-                    }
+            nerrors++;
+        }
+    }
 
-                    nerrors++;
-                }
-            }
+    // test for some corners of zoneToTest inside zoneRef
+    for( auto iterator = testSmoothedPoly.CIterateWithHoles(); iterator; iterator++ )
+    {
+        VECTOR2I currentVertex = *iterator;
 
-            // Iterate through all the segments of refSmoothedPoly
-            for( auto refIt = refSmoothedPoly.IterateSegmentsWithHoles(); refIt; refIt++ )
+        if( refSmoothedPoly.Contains( currentVertex ) )
+        {
+            // COPPERAREA_COPPERAREA error: copper area corner inside copper area ref
+            if( aMarkers )
             {
-                // Build ref segment
-                SEG refSegment = *refIt;
+                wxPoint pt( currentVertex.x, currentVertex.y );
+                aMarkers->push_back( new MARKER_PCB( units, COPPERAREA_INSIDE_COPPERAREA,
+                                                     pt, zoneToTest, pt, zoneRef, pt ) );
+            }
+
+            nerrors++;
+        }
+    }
+
+    // Iterate through all the segments of refSmoothedPoly
+    for( auto refIt = refSmoothedPoly.IterateSegmentsWithHoles(); refIt; refIt++ )
+    {
+        // Build ref segment
+        SEG refSegment = *refIt;
 
-                // Iterate through all the segments in testSmoothedPoly
-                for( auto testIt = testSmoothedPoly.IterateSegmentsWithHoles(); testIt; testIt++ )
+        // Iterate through all the segments in testSmoothedPoly
+        for( auto testIt = testSmoothedPoly.IterateSegmentsWithHoles(); testIt; testIt++ )
+        {
+            // Build test segment
+            SEG testSegment = *testIt;
+            wxPoint pt;
+
+            int ax1, ay1, ax2, ay2;
+            ax1 = refSegment.A.x;
+            ay1 = refSegment.A.y;
+            ax2 = refSegment.B.x;
+            ay2 = refSegment.B.y;
+
+            int bx1, by1, bx2, by2;
+            bx1 = testSegment.A.x;
+            by1 = testSegment.A.y;
+            bx2 = testSegment.B.x;
+            by2 = testSegment.B.y;
+
+            int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2,
+                                                 0,
+                                                 ax1, ay1, ax2, ay2,
+                                                 0,
+                                                 zone2zoneClearance,
+                                                 &pt.x, &pt.y );
+
+            if( d < zone2zoneClearance )
+            {
+                // COPPERAREA_COPPERAREA error : intersect or too close
+                if( aMarkers )
                 {
-                    // Build test segment
-                    SEG testSegment = *testIt;
-                    wxPoint pt;
-
-                    int ax1, ay1, ax2, ay2;
-                    ax1 = refSegment.A.x;
-                    ay1 = refSegment.A.y;
-                    ax2 = refSegment.B.x;
-                    ay2 = refSegment.B.y;
-
-                    int bx1, by1, bx2, by2;
-                    bx1 = testSegment.A.x;
-                    by1 = testSegment.A.y;
-                    bx2 = testSegment.B.x;
-                    by2 = testSegment.B.y;
-
-                    int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2,
-                                                         0,
-                                                         ax1, ay1, ax2, ay2,
-                                                         0,
-                                                         zone2zoneClearance,
-                                                         &pt.x, &pt.y );
-
-                    if( d < zone2zoneClearance )
-                    {
-                        // COPPERAREA_COPPERAREA error : intersect or too close
-                        if( aCreateMarkers )
-                        {
-                            auto marker = new MARKER_PCB( units, COPPERAREA_CLOSE_TO_COPPERAREA,
-                                                          pt, zoneRef, pt, zoneToTest, pt );
-                            commit.Add( marker );
-                        }
-
-                        nerrors++;
-                    }
+                    aMarkers->push_back( new MARKER_PCB( units, COPPERAREA_CLOSE_TO_COPPERAREA,
+                                                         pt, zoneRef, pt, zoneToTest, pt ) );
                 }
+
+                nerrors++;
             }
         }
     }
 
-    if( aCreateMarkers )
-        commit.Push( wxEmptyString, false, false );
-
     return nerrors;
 }
 
@@ -391,6 +480,7 @@ void DRC::RunTests( wxTextCtrl* aMessages )
     // be sure m_pcb is the current board, not a old one
     // ( the board can be reloaded )
     m_pcb = m_pcbEditorFrame->GetBoard();
+    m_units = m_pcbEditorFrame->GetUserUnits();
 
     // someone should have cleared the two lists before calling this.
 
@@ -533,6 +623,518 @@ void DRC::RunTests( wxTextCtrl* aMessages )
 }
 
 
+/**
+ * @return true if markers of the given error code are created by the tests re-run by
+ * DRC::RunIncrementalTests().
+ */
+static bool isIncrementalTestError( int aErrorCode )
+{
+    switch( aErrorCode )
+    {
+    case DRCE_TRACK_NEAR_THROUGH_HOLE:
+    case DRCE_TRACK_NEAR_PAD:
+    case DRCE_TRACK_NEAR_VIA:
+    case DRCE_VIA_NEAR_VIA:
+    case DRCE_VIA_NEAR_TRACK:
+    case DRCE_TRACK_ENDS1:
+    case DRCE_TRACK_ENDS2:
+    case DRCE_TRACK_ENDS3:
+    case DRCE_TRACK_ENDS4:
+    case DRCE_TRACK_SEGMENTS_TOO_CLOSE:
+    case DRCE_TRACKS_CROSSING:
+    case DRCE_ENDS_PROBLEM1:
+    case DRCE_ENDS_PROBLEM2:
+    case DRCE_ENDS_PROBLEM3:
+    case DRCE_ENDS_PROBLEM4:
+    case DRCE_ENDS_PROBLEM5:
+    case DRCE_PAD_NEAR_PAD1:
+    case DRCE_VIA_HOLE_BIGGER:
+    case DRCE_MICRO_VIA_INCORRECT_LAYER_PAIR:
+    case COPPERAREA_INSIDE_COPPERAREA:
+    case COPPERAREA_CLOSE_TO_COPPERAREA:
+    case DRCE_HOLE_NEAR_PAD:
+    case DRCE_HOLE_NEAR_TRACK:
+    case DRCE_TOO_SMALL_TRACK_WIDTH:
+    case DRCE_TOO_SMALL_VIA:
+    case DRCE_TOO_SMALL_MICROVIA:
+    case DRCE_TOO_SMALL_VIA_DRILL:
+    case DRCE_TOO_SMALL_MICROVIA_DRILL:
+    case DRCE_VIA_INSIDE_KEEPOUT:
+    case DRCE_TRACK_INSIDE_KEEPOUT:
+    case DRCE_MICRO_VIA_NOT_ALLOWED:
+    case DRCE_BURIED_VIA_NOT_ALLOWED:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+void DRC::clearMarkers( const std::vector<MARKER_PCB*>& aMarkers )
+{
+    if( aMarkers.empty() )
+        return;
+
+    if( !m_pcbEditorFrame )
+    {
+        for( MARKER_PCB* marker : aMarkers )
+            m_pcb->Delete( marker );
+
+        return;
+    }
+
+    // clear curr item, because it could be a DRC marker
+    if( std::find( aMarkers.begin(), aMarkers.end(), m_pcbEditorFrame->GetCurItem() )
+            != aMarkers.end() )
+    {
+        m_pcbEditorFrame->SetCurItem( NULL );
+    }
+
+    BOARD_COMMIT commit( m_pcbEditorFrame );
+
+    for( MARKER_PCB* marker : aMarkers )
+        commit.Remove( marker );
+
+    commit.Push( wxEmptyString, false, false );
+
+    // No undo entry was created, so the removed markers are still ours to delete
+    for( MARKER_PCB* marker : aMarkers )
+        delete marker;
+}
+
+
+void DRC::RunIncrementalTests( const EDA_RECT& aDirtyArea )
+{
+    RunIncrementalTests( std::vector<EDA_RECT>( 1, aDirtyArea ) );
+}
+
+
+void DRC::RunIncrementalTests( const std::vector<EDA_RECT>& aDirtyAreas )
+{
+    // be sure m_pcb is the current board, not a old one
+    updatePointers();
+
+    // BOARD_COMMIT::Push() keeps the R-tree of the connectivity algorithm up to date, so
+    // the pads, tracks and vias around the changes are found without visiting the board
+    auto     connAlgo = m_pcb->GetConnectivity()->GetConnectivityAlgo();
+    int      maxClearance = m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+
+    std::vector<BOX2I>                  areas;
+    std::vector<BOARD_CONNECTED_ITEM*>  retest;         // the pads, tracks and vias to test
+    std::set<const void*>               retestSet;
+    std::set<const void*>               changed;        // the items in the areas
+    std::set<ZONE_CONTAINER*>           changedZones;
+
+    // Any item closer than the biggest clearance to a change can have gained or lost a
+    // violation with a changed item
+    std::map<const void*, BOARD_CONNECTED_ITEM*> nearItems;
+
+    auto findItems = [&]( BOX2I aArea, int aClearance,
+                          const std::function<void( BOARD_CONNECTED_ITEM* )>& aFunc )
+    {
+        auto visitor = [&]( CN_ITEM* aItem ) -> bool
+        {
+            // Removed items stay in the R-tree until the next connectivity update
+            if( aItem->Valid() )
+                aFunc( aItem->Parent() );
+
+            return true;
+        };
+
+        aArea.Inflate( aClearance );
+        connAlgo->ItemList().FindNearby( aArea, visitor );
+    };
+
+    auto addRetest = [&]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        if( retestSet.insert( aItem ).second )
+            retest.push_back( aItem );
+    };
+
+    auto addNear = [&]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        nearItems[ aItem ] = aItem;
+    };
+
+    for( EDA_RECT area : aDirtyAreas )
+    {
+        area.Normalize();
+        areas.emplace_back( area.GetPosition(), area.GetSize() );
+
+        findItems( areas.back(), 0, [&]( BOARD_CONNECTED_ITEM* aItem )
+                {
+                    changed.insert( aItem );
+                    addRetest( aItem );
+                } );
+
+        findItems( areas.back(), maxClearance, addNear );
+    }
+
+    // A changed item can extend far outside of the areas.  The tracks close to a changed
+    // pad are tested again, as only the tracks test their clearance to the pads.
+    for( size_t ii = 0; ii < retest.size(); ++ii )
+    {
+        BOARD_CONNECTED_ITEM* item = retest[ii];
+        EDA_RECT              bbox = item->GetBoundingBox();
+
+        findItems( BOX2I( bbox.GetPosition(), bbox.GetSize() ), maxClearance,
+                [&]( BOARD_CONNECTED_ITEM* aNear )
+                {
+                    addNear( aNear );
+
+                    if( item->Type() == PCB_PAD_T && aNear->Type() != PCB_PAD_T )
+                        addRetest( aNear );
+                } );
+    }
+
+    for( ZONE_CONTAINER* zone : m_pcb->Zones() )
+    {
+        EDA_RECT bbox = zone->GetBoundingBox();
+        BOX2I    zoneBox( bbox.GetPosition(), bbox.GetSize() );
+
+        for( const BOX2I& area : areas )
+        {
+            if( area.Intersects( zoneBox ) )
+            {
+                changedZones.insert( zone );
+                changed.insert( zone );
+                break;
+            }
+        }
+    }
+
+    // Remove the markers of the changes: the ones referring to a changed item, or located
+    // in an area (for the removed items).  The item which reported such a marker is
+    // tested again, unless it was removed.
+    std::vector<MARKER_PCB*> markers;
+    std::set<MARKER_PCB*>    removed;
+
+    for( int ii = 0; ii < m_pcb->GetMARKERCount(); ++ii )
+    {
+        MARKER_PCB*     marker = m_pcb->GetMARKER( ii );
+        const DRC_ITEM& item = marker->GetReporter();
+        bool            inArea = false;
+
+        if( !isIncrementalTestError( item.GetErrorCode() ) )
+            continue;
+
+        for( const BOX2I& area : areas )
+        {
+            if( area.Contains( item.GetPointA() )
+                    || ( item.HasSecondItem() && area.Contains( item.GetPointB() ) ) )
+            {
+                inArea = true;
+                break;
+            }
+        }
+
+        if( inArea || changed.count( item.GetMainItemWeakRef() )
+                || changed.count( item.GetAuxItemWeakRef() ) )
+        {
+            markers.push_back( marker );
+            removed.insert( marker );
+
+            auto reporter = nearItems.find( item.GetMainItemWeakRef() );
+
+            if( reporter != nearItems.end() )
+                addRetest( reporter->second );
+        }
+    }
+
+    // The items tested again report all their markers again, but do not report again the
+    // markers kept for other items
+    std::set<std::pair<const void*, const void*>> keptPairs;
+
+    for( int ii = 0; ii < m_pcb->GetMARKERCount(); ++ii )
+    {
+        MARKER_PCB*     marker = m_pcb->GetMARKER( ii );
+        const DRC_ITEM& item = marker->GetReporter();
+
+        if( !isIncrementalTestError( item.GetErrorCode() ) || removed.count( marker ) )
+            continue;
+
+        if( retestSet.count( item.GetMainItemWeakRef() ) )
+            markers.push_back( marker );
+        else if( retestSet.count( item.GetAuxItemWeakRef() ) )
+            keptPairs.emplace( item.GetMainItemWeakRef(), item.GetAuxItemWeakRef() );
+    }
+
+    clearMarkers( markers );
+
+    testItemsNear( retest, keptPairs );
+
+    if( m_doKeepoutTest )
+    {
+        std::vector<TRACK*> tracks;
+
+        for( BOARD_CONNECTED_ITEM* item : retest )
+        {
+            if( item->Type() == PCB_TRACE_T || item->Type() == PCB_VIA_T )
+                tracks.push_back( static_cast<TRACK*>( item ) );
+        }
+
+        testKeepoutAreas( &tracks );
+    }
+
+    if( !changedZones.empty() )
+        testZonesNear( changedZones );
+
+    m_incrementalTestCount = retest.size() + changedZones.size();
+
+    // update the m_drcDialog listboxes
+    updatePointers();
+}
+
+
+void DRC::testItemsNear( const std::vector<BOARD_CONNECTED_ITEM*>& aItems,
+                         const std::set<std::pair<const void*, const void*>>& aSkippedPairs )
+{
+    auto connAlgo = m_pcb->GetConnectivity()->GetConnectivityAlgo();
+    int  maxClearance = m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+
+    std::map<const void*, size_t> order;
+
+    for( size_t ii = 0; ii < aItems.size(); ++ii )
+        order[ aItems[ii] ] = ii;
+
+    std::vector<TRACK*> tracks;
+    std::vector<D_PAD*> pads;
+
+    for( size_t ii = 0; ii < aItems.size(); ++ii )
+    {
+        BOARD_CONNECTED_ITEM* ref = aItems[ii];
+        bool                  refIsPad = ref->Type() == PCB_PAD_T;
+
+        if( refIsPad && !m_doPad2PadTest )
+            continue;
+
+        tracks.clear();
+        pads.clear();
+
+        auto visitor = [&]( CN_ITEM* aItem ) -> bool
+        {
+            // Removed items stay in the R-tree until the next connectivity update
+            if( !aItem->Valid() || aItem->Parent() == ref )
+                return true;
+
+            BOARD_CONNECTED_ITEM* candidate = aItem->Parent();
+            bool                  isPad = candidate->Type() == PCB_PAD_T;
+
+            // Only the tracks test their clearance to the pads
+            if( refIsPad && !isPad )
+                return true;
+
+            // A pair of given items of the same kind is tested by the first one
+            auto it = order.find( candidate );
+
+            if( isPad == refIsPad && it != order.end() && it->second < ii )
+                return true;
+
+            if( aSkippedPairs.count( std::make_pair( (const void*) candidate, (const void*) ref ) ) )
+                return true;
+
+            if( isPad )
+                pads.push_back( static_cast<D_PAD*>( candidate ) );
+            else
+                tracks.push_back( static_cast<TRACK*>( candidate ) );
+
+            return true;
+        };
+
+        EDA_RECT bbox = ref->GetBoundingBox();
+        BOX2I    area( bbox.GetPosition(), bbox.GetSize() );
+
+        area.Inflate( maxClearance + 1 );
+        connAlgo->ItemList().FindNearby( area, visitor );
+
+        if( refIsPad )
+        {
+            // The candidates are not sorted by X coordinate: do not use the X limit
+            if( !doPadToPadsDrc( static_cast<D_PAD*>( ref ), pads.data(),
+                                 pads.data() + pads.size(), INT_MAX ) )
+            {
+                wxASSERT( m_currentMarker );
+                addMarkerToPcb( m_currentMarker );
+                m_currentMarker = nullptr;
+            }
+        }
+        else if( !doTrackDrc( static_cast<TRACK*>( ref ), tracks.data(),
+                              tracks.data() + tracks.size(), true, &pads ) )
+        {
+            if( m_currentMarker )
+            {
+                addMarkerToPcb( m_currentMarker );
+                m_currentMarker = nullptr;
+            }
+        }
+    }
+}
+
+
+void DRC::testZonesNear( const std::set<ZONE_CONTAINER*>& aZones )
+{
+    int                             maxClearance =
+                                        m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+    std::vector<MARKER_PCB*>        markers;
+    std::set<const ZONE_CONTAINER*> boardZones;
+
+    for( int ia = 0; ia < m_pcb->GetAreaCount(); ia++ )
+        boardZones.insert( m_pcb->GetArea( ia ) );
+
+    // Forget the outlines of the deleted zones
+    for( auto it = m_smoothedZones.begin(); it != m_smoothedZones.end(); )
+    {
+        if( boardZones.count( it->first ) )
+            ++it;
+        else
+            it = m_smoothedZones.erase( it );
+    }
+
+    for( ZONE_CONTAINER* zone : aZones )
+    {
+        for( int ia = 0; ia < m_pcb->GetAreaCount(); ia++ )
+        {
+            ZONE_CONTAINER* other = m_pcb->GetArea( ia );
+            int             clearance = std::max( maxClearance,
+                                                  std::max( zone->GetZoneClearance(),
+                                                            other->GetZoneClearance() ) );
+            EDA_RECT        area = zone->GetBoundingBox();
+
+            area.Inflate( clearance );
+
+            if( other == zone || !area.Intersects( other->GetBoundingBox() ) )
+                continue;
+
+            // A pair of given zones is tested in each direction by the loop
+            if( zone->IsOnCopperLayer() )
+            {
+                doZoneToZoneDrc( zone, getSmoothedPoly( zone ), other, getSmoothedPoly( other ),
+                                 &markers );
+            }
+
+            if( other->IsOnCopperLayer() && !aZones.count( other ) )
+            {
+                doZoneToZoneDrc( other, getSmoothedPoly( other ), zone, getSmoothedPoly( zone ),
+                                 &markers );
+            }
+        }
+    }
+
+    addMarkersToPcb( markers );
+}
+
+
+/**
+ * @return true if aPolysA and aPolysB have the same contours, with the same vertices.
+ */
+static bool sameOutline( const SHAPE_POLY_SET& aPolysA, const SHAPE_POLY_SET& aPolysB )
+{
+    if( aPolysA.OutlineCount() != aPolysB.OutlineCount() )
+        return false;
+
+    for( int ii = 0; ii < aPolysA.OutlineCount(); ii++ )
+    {
+        const SHAPE_POLY_SET::POLYGON& polyA = aPolysA.CPolygon( ii );
+        const SHAPE_POLY_SET::POLYGON& polyB = aPolysB.CPolygon( ii );
+
+        if( polyA.size() != polyB.size() )
+            return false;
+
+        for( size_t jj = 0; jj < polyA.size(); jj++ )
+        {
+            if( polyA[jj].PointCount() != polyB[jj].PointCount() )
+                return false;
+
+            for( int kk = 0; kk < polyA[jj].PointCount(); kk++ )
+            {
+                if( polyA[jj].CPoint( kk ) != polyB[jj].CPoint( kk ) )
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+SHAPE_POLY_SET& DRC::getSmoothedPoly( const ZONE_CONTAINER* aZone )
+{
+    std::unique_ptr<SMOOTHED_ZONE>& entry = m_smoothedZones[ aZone ];
+
+    // The zones changed outside of BOARD_COMMIT::Push() (e.g. by undo) are found here
+    if( entry && entry->m_smoothingType == aZone->GetCornerSmoothingType()
+            && entry->m_cornerRadius == aZone->GetCornerRadius()
+            && entry->m_arcSegmentCount == aZone->GetArcSegmentCount()
+            && sameOutline( entry->m_outline, *aZone->Outline() ) )
+    {
+        return entry->m_smoothedPoly;
+    }
+
+    if( !entry )
+        entry.reset( new SMOOTHED_ZONE );
+
+    entry->m_outline         = *aZone->Outline();
+    entry->m_smoothingType   = aZone->GetCornerSmoothingType();
+    entry->m_cornerRadius    = aZone->GetCornerRadius();
+    entry->m_arcSegmentCount = aZone->GetArcSegmentCount();
+
+    entry->m_smoothedPoly.RemoveAllContours();
+    aZone->BuildSmoothedPoly( entry->m_smoothedPoly );
+    entry->m_smoothedPoly.CachePointIndex();
+
+    return entry->m_smoothedPoly;
+}
+
+
+void DRC::RunBatchTests()
+{
+    m_passTimes.clear();
+    m_drcInLegacyRoutingMode = false;
+
+    auto runPass = [&]( const wxString& aName, const std::function<void()>& aPass )
+    {
+        PROF_COUNTER counter;
+
+        aPass();
+        m_passTimes.emplace_back( aName, counter.msecs() );
+    };
+
+    bool netclassesOk = true;
+
+    runPass( wxT( "netclasses" ), [&]() { netclassesOk = testNetClasses(); } );
+
+    // See RunTests(): when the netclasses are wrong, every item would fail
+    if( !netclassesOk )
+        return;
+
+    if( m_doPad2PadTest )
+        runPass( wxT( "pad_clearances" ), [&]() { testPad2Pad(); } );
+
+    runPass( wxT( "drill_clearances" ), [&]() { testDrilledHoles(); } );
+    runPass( wxT( "track_clearances" ), [&]() { testTracks( nullptr, false ); } );
+
+    // Zones are tested as they are stored in the board: the batch mode does not refill them
+    runPass( wxT( "zones" ), [&]() { testZones(); } );
+
+    if( m_doUnconnectedTest )
+        runPass( wxT( "unconnected" ), [&]() { testUnconnected(); } );
+
+    if( m_doKeepoutTest )
+        runPass( wxT( "keepout_areas" ), [&]() { testKeepoutAreas(); } );
+
+    runPass( wxT( "texts" ), [&]() { testTexts(); } );
+
+    if( m_pcb->GetDesignSettings().m_ProhibitOverlappingCourtyards
+        || m_pcb->GetDesignSettings().m_RequireCourtyards )
+    {
+        runPass( wxT( "courtyards" ), [&]() { doFootprintOverlappingDrc(); } );
+    }
+
+    runPass( wxT( "disabled_layers" ), [&]() { testDisabledLayers(); } );
+}
+
+
 void DRC::ListUnconnectedPads()
 {
     testUnconnected();
@@ -544,8 +1146,13 @@ void DRC::ListUnconnectedPads()
 
 void DRC::updatePointers()
 {
+    // In batch mode, there is no frame: the board and the units never change
+    if( !m_pcbEditorFrame )
+        return;
+
     // update my pointers, m_pcbEditorFrame is the only unchangeable one
     m_pcb = m_pcbEditorFrame->GetBoard();
+    m_units = m_pcbEditorFrame->GetUserUnits();
 
     if( m_drcDialog )  // Use diag list boxes only in DRC dialog
     {
@@ -565,7 +1172,7 @@ bool DRC::doNetClass( const NETCLASSPTR& nc, wxString& msg )
 
     const BOARD_DESIGN_SETTINGS& g = m_pcb->GetDesignSettings();
 
-#define FmtVal( x ) GetChars( StringFromValue( m_pcbEditorFrame->GetUserUnits(), x ) )
+#define FmtVal( x ) GetChars( StringFromValue( m_units, x ) )
 
 #if 0   // set to 1 when (if...) BOARD_DESIGN_SETTINGS has a m_MinClearance value
     if( nc->GetClearance() < g.m_MinClearance )
@@ -781,7 +1388,7 @@ void DRC::testDrilledHoles()
             if( KiROUND( GetLineLength( checkHole.m_location, refHole.m_location ) )
                     <  checkHole.m_drillRadius + refHole.m_drillRadius + holeToHoleMin )
             {
-                addMarkerToPcb( new MARKER_PCB( m_pcbEditorFrame->GetUserUnits(),
+                addMarkerToPcb( new MARKER_PCB( m_units,
                                                 DRCE_DRILLED_HOLES_TOO_CLOSE, refHole.m_location,
                                                 refHole.m_owner, refHole.m_location,
                                                 checkHole.m_owner, checkHole.m_location ) );
@@ -796,12 +1403,12 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
     wxProgressDialog * progressDialog = NULL;
     const int delta = 500;  // This is the number of tests between 2 calls to the
                             // progress bar
-    int count = 0;
+    std::vector<TRACK*> tracks;
 
-    for( TRACK* segm = m_pcb->m_Track; segm && segm->Next(); segm = segm->Next() )
-        count++;
+    for( TRACK* segm = m_pcb->m_Track; segm; segm = segm->Next() )
+        tracks.push_back( segm );
 
-    int deltamax = count/delta;
+    int deltamax = tracks.size() / delta;
 
     if( aShowProgressBar && deltamax > 3 )
     {
@@ -813,10 +1420,75 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
         progressDialog->Update( 0, wxEmptyString );
     }
 
+    // Broadphase: each copper layer gets its own R-tree of track indices, so a segment
+    // is only compared to the later segments whose bounding box is within the biggest
+    // clearance of its own.  The narrowphase (doTrackDrc) keeps the list order, so the
+    // markers are created in the same order as a full pairwise walk would create them.
+    typedef RTree<size_t, int, 2, float> TRACK_INDEX;
+
+    std::vector<TRACK_INDEX> layerIndex( MAX_CU_LAYERS );
+    int maxClearance = m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        EDA_RECT    bbox = tracks[ii]->GetBoundingBox();
+        const int   mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int   mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        for( PCB_LAYER_ID layer : tracks[ii]->GetLayerSet().CuStack() )
+            layerIndex[ layer ].Insert( mmin, mmax, ii );
+    }
+
+    // The R-tree queries are read-only, so the candidate lists are collected in parallel
+    std::vector<std::vector<TRACK*>> candidates( tracks.size() );
+    std::atomic<size_t> next( 0 );
+    std::vector<std::thread> queryWorkers;
+    int parallelThreadCount = std::max( ( int )std::thread::hardware_concurrency(), 2 );
+
+    for( int ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        queryWorkers.push_back( std::thread( [&]()
+        {
+            std::vector<size_t> found;
+
+            for( size_t i = next.fetch_add( 1 ); i < tracks.size(); i = next.fetch_add( 1 ) )
+            {
+                EDA_RECT bbox = tracks[i]->GetBoundingBox();
+                bbox.Inflate( maxClearance + 1 );
+
+                const int mmin[2] = { bbox.GetX(), bbox.GetY() };
+                const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+                auto visitor = [&]( size_t aCandidate ) -> bool
+                {
+                    if( aCandidate > i )
+                        found.push_back( aCandidate );
+
+                    return true;
+                };
+
+                found.clear();
+
+                for( PCB_LAYER_ID layer : tracks[i]->GetLayerSet().CuStack() )
+                    layerIndex[ layer ].Search( mmin, mmax, visitor );
+
+                // vias are indexed on each of their layers
+                std::sort( found.begin(), found.end() );
+                found.erase( std::unique( found.begin(), found.end() ), found.end() );
+
+                for( size_t candidate : found )
+                    candidates[i].push_back( tracks[ candidate ] );
+            }
+        } ) );
+    }
+
+    for( auto& worker : queryWorkers )
+        worker.join();
+
     int ii = 0;
-    count = 0;
+    int count = 0;
 
-    for( TRACK* segm = m_pcb->m_Track; segm; segm = segm->Next() )
+    for( size_t i = 0; i < tracks.size(); ++i )
     {
         if( ii++ > delta )
         {
@@ -835,7 +1507,9 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
             }
         }
 
-        if( !doTrackDrc( segm, segm->Next(), true ) )
+        std::vector<TRACK*>& segms = candidates[i];
+
+        if( !doTrackDrc( tracks[i], segms.data(), segms.data() + segms.size(), true ) )
         {
             if( m_currentMarker )
             {
@@ -843,6 +1517,9 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
                 m_currentMarker = nullptr;
             }
         }
+
+        // Release the candidate list as soon as it is tested
+        std::vector<TRACK*>().swap( segms );
     }
 
     if( progressDialog )
@@ -852,9 +1529,10 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
 
 void DRC::testUnconnected()
 {
-
     auto connectivity = m_pcb->GetConnectivity();
 
+    // The ratsnest updates made after each edit only search the changed nets.
+    // A DRC run does not rely on them:
     connectivity->Clear();
     connectivity->Build( m_pcb ); // just in case. This really needs to be reliable.
     connectivity->RecalculateRatsnest();
@@ -867,7 +1545,7 @@ void DRC::testUnconnected()
         auto src = edge.GetSourcePos();
         auto dst = edge.GetTargetPos();
 
-        m_unconnected.emplace_back( new DRC_ITEM( m_pcbEditorFrame->GetUserUnits(),
+        m_unconnected.emplace_back( new DRC_ITEM( m_units,
                                                   DRCE_UNCONNECTED_ITEMS,
                                                   edge.GetSourceNode()->Parent(),
                                                   wxPoint( src.x, src.y ),
@@ -916,8 +1594,18 @@ void DRC::testZones()
 }
 
 
-void DRC::testKeepoutAreas()
+void DRC::testKeepoutAreas( const std::vector<TRACK*>* aTracks )
 {
+    std::vector<TRACK*> boardTracks;
+
+    if( !aTracks )
+    {
+        for( TRACK* segm = m_pcb->m_Track; segm != NULL; segm = segm->Next() )
+            boardTracks.push_back( segm );
+
+        aTracks = &boardTracks;
+    }
+
     // Test keepout areas for vias, tracks and pads inside keepout areas
     for( int ii = 0; ii < m_pcb->GetAreaCount(); ii++ )
     {
@@ -928,7 +1616,7 @@ void DRC::testKeepoutAreas()
             continue;
         }
 
-        for( TRACK* segm = m_pcb->m_Track; segm != NULL; segm = segm->Next() )
+        for( TRACK* segm : *aTracks )
         {
             if( segm->Type() == PCB_TRACE_T )
             {
@@ -1095,7 +1783,7 @@ void DRC::testTexts()
 
 void DRC::testDisabledLayers()
 {
-    BOARD* board = m_pcbEditorFrame->GetBoard();
+    BOARD* board = m_pcb;
     wxCHECK( board, /*void*/ );
     LSET disabledLayers = board->GetEnabledLayers().flip();
 
@@ -31,6 +31,8 @@
 
 #include <vector>
 #include <memory>
+#include <map>
+#include <set>
 
 #define OK_DRC  0
 #define BAD_DRC 1
@@ -98,6 +100,7 @@ class EDA_DRAW_PANEL;
 class PCB_EDIT_FRAME;
 class DIALOG_DRC_CONTROL;
 class BOARD_ITEM;
+class BOARD_CONNECTED_ITEM;
 class BOARD;
 class D_PAD;
 class ZONE_CONTAINER;
@@ -105,6 +108,8 @@ class TRACK;
 class MARKER_PCB;
 class DRC_ITEM;
 class NETCLASS;
+class EDA_RECT;
+class SHAPE_POLY_SET;
 
 
 /**
@@ -175,6 +180,7 @@ private:
     bool     m_doCreateRptFile;
     bool     m_refillZones;
     bool     m_reportAllTrackErrors;
+    bool     m_doIncrementalTest;
 
     wxString m_rptFilename;
 
@@ -218,6 +224,21 @@ private:
 
     DRC_LIST            m_unconnected;      ///< list of unconnected pads, as DRC_ITEMs
 
+    ///> Name and duration (in ms) of each pass of the last RunBatchTests() call
+    std::vector<std::pair<wxString, double>> m_passTimes;
+
+    ///> Number of pads, tracks, vias and zones tested by the last RunIncrementalTests() call
+    int                 m_incrementalTestCount;
+
+    ///> A zone outline and its smoothed version, see getSmoothedPoly()
+    struct SMOOTHED_ZONE;
+
+    ///> Smoothed zone outlines kept from one RunIncrementalTests() call to the next
+    std::map<const ZONE_CONTAINER*, std::unique_ptr<SMOOTHED_ZONE>> m_smoothedZones;
+
+    ///> Set the default values of the settings, common to all constructors
+    void init();
+
 
     /**
      * Update needed pointers from the one pointer which is known not to change.
@@ -279,6 +300,12 @@ private:
      */
     void addMarkerToPcb( MARKER_PCB* aMarker );
 
+    /**
+     * Adds DRC markers to the PCB in a single commit, or directly to the board
+     * in batch mode.
+     */
+    void addMarkersToPcb( const std::vector<MARKER_PCB*>& aMarkers );
+
     //-----<categorical group tests>-----------------------------------------
 
     /**
@@ -310,15 +337,57 @@ private:
 
     void testZones();
 
-    void testKeepoutAreas();
+    /**
+     * Test vias and tracks inside keepout areas.
+     *
+     * @param aTracks = if not NULL, only these tracks are tested
+     */
+    void testKeepoutAreas( const std::vector<TRACK*>* aTracks = nullptr );
 
     void testTexts();
 
     ///> Tests for items placed on disabled layers (causing false connections).
     void testDisabledLayers();
 
+    /**
+     * Remove the given markers from the board.
+     */
+    void clearMarkers( const std::vector<MARKER_PCB*>& aMarkers );
+
+    /**
+     * Test the given pads, tracks and vias against the copper items around them, found
+     * with the R-tree of the connectivity algorithm.  A pair of given items is tested once.
+     *
+     * @param aSkippedPairs = (reporting item, other item) pairs not to test again, because
+     * the marker reported for them is kept
+     */
+    void testItemsNear( const std::vector<BOARD_CONNECTED_ITEM*>& aItems,
+                        const std::set<std::pair<const void*, const void*>>& aSkippedPairs );
+
+    /**
+     * Test the outlines of the given zones against the outlines close to them, in both
+     * directions.
+     */
+    void testZonesNear( const std::set<ZONE_CONTAINER*>& aZones );
+
+    /**
+     * @return the smoothed outline of aZone, built again only when the outline or the
+     * smoothing settings of the zone changed since the previous call.
+     */
+    SHAPE_POLY_SET& getSmoothedPoly( const ZONE_CONTAINER* aZone );
+
     //-----<single "item" tests>-----------------------------------------
 
+    /**
+     * Test the clearance between two zone outlines.
+     *
+     * @param aMarkers if not NULL, receives the markers created for the errors found.
+     * @return Errors count
+     */
+    int doZoneToZoneDrc( ZONE_CONTAINER* aZoneRef, SHAPE_POLY_SET& aRefPoly,
+                         ZONE_CONTAINER* aZoneToTest, SHAPE_POLY_SET& aTestPoly,
+                         std::vector<MARKER_PCB*>* aMarkers );
+
     bool doNetClass( const std::shared_ptr<NETCLASS>& aNetClass, wxString& msg );
 
     /**
@@ -346,6 +415,20 @@ private:
      */
     bool doTrackDrc( TRACK* aRefSeg, TRACK* aStart, bool doPads = true );
 
+    /**
+     * Test the current segment against a range of candidate segments.
+     *
+     * @param aRefSeg The segment to test
+     * @param aStart the first item of the candidate list
+     * @param aEnd marker for the end of the candidate list (not included)
+     * @param doPads true if should do pads test
+     * @param aPads the pads to test when doPads is true, or NULL to test all the pads
+     * @return bool - true if no problems, else false and m_currentMarker is
+     *          filled in with the problem information.
+     */
+    bool doTrackDrc( TRACK* aRefSeg, TRACK** aStart, TRACK** aEnd, bool doPads = true,
+                     const std::vector<D_PAD*>* aPads = nullptr );
+
     /**
      * Test the current segment or via.
      *
@@ -431,6 +514,15 @@ private:
 public:
     DRC( PCB_EDIT_FRAME* aPcbWindow );
 
+    /**
+     * Create a DRC controller working without editor frame (batch mode), for instance
+     * from a script.  Markers are added directly to the board.
+     *
+     * @param aBoard is the board to test
+     * @param aUnits are the units used in the DRC messages
+     */
+    DRC( BOARD* aBoard, EDA_UNITS_T aUnits );
+
     ~DRC();
 
     /**
@@ -532,6 +624,57 @@ public:
      */
     void RunTests( wxTextCtrl* aMessages = NULL );
 
+    /**
+     * Re-run the pad, track, keepout and zone outline tests only for the items located in
+     * the modified areas of the board, keeping the markers found elsewhere by a previous
+     * run.
+     *
+     * The pads, tracks and vias are found with the R-tree that the connectivity algorithm
+     * keeps up to date, so the work depends on the size of the change, not on the size
+     * of the board.
+     *
+     * @param aDirtyAreas are the old and new bounding boxes of the items which have been
+     * added, modified or removed.
+     */
+    void RunIncrementalTests( const std::vector<EDA_RECT>& aDirtyAreas );
+
+    void RunIncrementalTests( const EDA_RECT& aDirtyArea );
+
+    /**
+     * @return the number of pads, tracks, vias and zones tested again by the last
+     * RunIncrementalTests() call.
+     */
+    int GetIncrementalTestCount() const { return m_incrementalTestCount; }
+
+    /**
+     * Enable or disable the incremental tests run by BOARD_COMMIT::Push() after each edit.
+     * The choice is saved in the pcbnew settings, and restored by the next board editor.
+     */
+    void SetIncrementalMode( bool aEnable );
+
+    bool IsIncrementalMode() const { return m_doIncrementalTest; }
+
+    /**
+     * Run all the tests specified with a previous call to SetSettings(), without any UI
+     * and without refilling the zones, and record the time spent in each pass.
+     * Can be used in batch mode.
+     */
+    void RunBatchTests();
+
+    /**
+     * Access to the passes run by the last RunBatchTests() call, and to their duration
+     * in milliseconds.
+     */
+    int GetPassCount() const { return (int) m_passTimes.size(); }
+    wxString GetPassName( int aIndex ) const { return m_passTimes[aIndex].first; }
+    double GetPassTime( int aIndex ) const { return m_passTimes[aIndex].second; }
+
+    /**
+     * Access to the unconnected items found by the last run.
+     */
+    int GetUnconnectedCount() const { return (int) m_unconnected.size(); }
+    const DRC_ITEM* GetUnconnectedItem( int aIndex ) const { return m_unconnected[aIndex]; }
+
     /**
      * Gather a list of all the unconnected pads and shows them in the
      * dialog, and optionally prints a report of such.
@@ -136,6 +136,20 @@ bool convex2pointDRC( wxPoint* aTref, int aTrefCount, wxPoint aPcompare, int aDi
 
 
 bool DRC::doTrackDrc( TRACK* aRefSeg, TRACK* aStart, bool testPads )
+{
+    std::vector<TRACK*> tracks;
+
+    for( TRACK* track = aStart; track; track = track->Next() )
+        tracks.push_back( track );
+
+    TRACK** listEnd = tracks.data() + tracks.size();
+
+    return doTrackDrc( aRefSeg, tracks.data(), listEnd, testPads );
+}
+
+
+bool DRC::doTrackDrc( TRACK* aRefSeg, TRACK** aStart, TRACK** aEnd, bool testPads,
+                      const std::vector<D_PAD*>* aPads )
 {
     TRACK*    track;
     wxPoint   delta;           // length on X and Y axis of segments
@@ -160,12 +174,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACK* aStart, bool testPads )
         }
         else
         {
-            BOARD_COMMIT commit( m_pcbEditorFrame );
-
-            for( auto marker : markers )
-                commit.Add( marker );
-
-            commit.Push( wxEmptyString, false, false );
+            addMarkersToPcb( markers );
+            markers.clear();
         }
     };
 
@@ -343,13 +353,16 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACK* aStart, bool testPads )
     // Compute the min distance to pads
     if( testPads )
     {
-        unsigned pad_count = m_pcb->GetPadCount();
+        std::vector<D_PAD*> boardPads;
 
-        auto pads = m_pcb->GetPads();
+        if( !aPads )
+        {
+            boardPads = m_pcb->GetPads();
+            aPads = &boardPads;
+        }
 
-        for( unsigned ii = 0; ii < pad_count; ++ii )
+        for( D_PAD* pad : *aPads )
         {
-            D_PAD* pad = pads[ii];
 
             /* No problem if pads are on another layer,
              * But if a drill hole exists	(a pad on a single layer can have a hole!)
@@ -415,8 +428,10 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACK* aStart, bool testPads )
     wxPoint segStartPoint;
     wxPoint segEndPoint;
 
-    for( track = aStart; track; track = track->Next() )
+    for( TRACK** it = aStart; it < aEnd; ++it )
     {
+        track = *it;
+
         // No problem if segments have the same net code:
         if( net_code_ref == track->GetNetCode() )
             continue;
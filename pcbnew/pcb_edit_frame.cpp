@@ -312,6 +312,8 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
     // We don't know what state board was in when it was lasat saved, so we have to
     // assume dirty
     m_ZoneFillsDirty = true;
+    m_zoneFillsDirtyAreaValid = false;
+    m_zoneFillsDirtyAreaPending = false;
 
     m_rotationAngle = 900;
 
@@ -1064,10 +1066,44 @@ void PCB_EDIT_FRAME::OnModify( )
 
     Update3DView();
 
+    // Changes not recorded by AddZoneFillsDirtyArea() can be anywhere
+    if( !m_zoneFillsDirtyAreaPending )
+        m_zoneFillsDirtyAreaValid = false;
+
+    m_zoneFillsDirtyAreaPending = false;
     m_ZoneFillsDirty = true;
 }
 
 
+void PCB_EDIT_FRAME::AddZoneFillsDirtyArea( const EDA_RECT& aArea )
+{
+    if( m_ZoneFillsDirty )
+        m_zoneFillsDirtyArea.Merge( aArea );
+    else
+        m_zoneFillsDirtyArea = aArea;
+
+    m_zoneFillsDirtyAreaPending = true;
+}
+
+
+bool PCB_EDIT_FRAME::GetZoneFillsDirtyArea( EDA_RECT& aArea ) const
+{
+    if( !m_ZoneFillsDirty || !m_zoneFillsDirtyAreaValid )
+        return false;
+
+    aArea = m_zoneFillsDirtyArea;
+    return true;
+}
+
+
+void PCB_EDIT_FRAME::ClearZoneFillsDirty()
+{
+    m_ZoneFillsDirty = false;
+    m_zoneFillsDirtyAreaValid = true;
+    m_zoneFillsDirtyAreaPending = false;
+}
+
+
 void PCB_EDIT_FRAME::ExportSVG( wxCommandEvent& event )
 {
     InvokeExportSVG( this, GetBoard() );
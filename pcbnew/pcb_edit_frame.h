@@ -89,6 +89,10 @@ protected:
 
     wxString          m_lastNetListRead;        ///< Last net list read with relative path.
 
+    EDA_RECT          m_zoneFillsDirtyArea;     ///< Area changed since the last zone fill.
+    bool              m_zoneFillsDirtyAreaValid;    ///< false if other changes were made.
+    bool              m_zoneFillsDirtyAreaPending;  ///< The next OnModify() is a known change.
+
     // The Tool Framework initalization
     void setupTools();
 
@@ -250,6 +254,27 @@ public:
 
     bool m_ZoneFillsDirty;                  // Board has been modified since last zone fill.
 
+    /**
+     * Function AddZoneFillsDirtyArea
+     * records the area changed by a commit, so the next fill of all zones can be
+     * limited to it.  It must be called before OnModify() for the same change: any
+     * other modification makes the changed area unknown.
+     */
+    void AddZoneFillsDirtyArea( const EDA_RECT& aArea );
+
+    /**
+     * Function GetZoneFillsDirtyArea
+     * @param aArea receives the area modified since the last fill of all zones.
+     * @return false if this area is unknown, and all zones must be refilled.
+     */
+    bool GetZoneFillsDirtyArea( EDA_RECT& aArea ) const;
+
+    /**
+     * Function ClearZoneFillsDirty
+     * marks all zone fills as up to date.
+     */
+    void ClearZoneFillsDirty();
+
     virtual ~PCB_EDIT_FRAME();
 
     /**
@@ -50,8 +50,15 @@
 #include <zones.h>
 #include <pcb_parser.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace PCB_KEYS_T;
 
+///> size of the text of the tracks and vias given to a single worker thread
+static const size_t TRACK_LIST_SIZE = 64 * 1024;
+
 
 void PCB_PARSER::init()
 {
@@ -497,6 +504,7 @@ BOARD* PCB_PARSER::parseBOARD()
 BOARD* PCB_PARSER::parseBOARD_unchecked()
 {
     T token;
+    std::vector<BOARD_ITEM_LIST> lists;
 
     parseHeader();
 
@@ -554,19 +562,30 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
             break;
 
         case T_module:
-            m_board->Add( parseMODULE(), ADD_APPEND );
-            break;
-
         case T_segment:
-            m_board->Add( parseTRACK(), ADD_INSERT );
-            break;
-
         case T_via:
-            m_board->Add( parseVIA(), ADD_INSERT );
-            break;
-
         case T_zone:
-            m_board->Add( parseZONE_CONTAINER(), ADD_APPEND );
+        {
+            // Only copied here, parsed in parallel once the whole board is read.
+            // Tracks and vias are small: consecutive ones share a buffer.
+            bool isTrack = token == T_segment || token == T_via;
+
+            if( !isTrack || lists.empty() || lists.back().m_token != T_segment
+                    || lists.back().m_text.size() > TRACK_LIST_SIZE )
+            {
+                lists.emplace_back();
+                lists.back().m_token    = isTrack ? T_segment : token;
+                lists.back().m_line     = CurLineNumber();
+                lists.back().m_lastLine = CurLineNumber();
+            }
+
+            BOARD_ITEM_LIST& list = lists.back();
+
+            // Keep the line numbers of the file, for the error messages
+            list.m_text.append( CurLineNumber() - list.m_lastLine, '\n' );
+            ReadRawList( &list.m_text );
+            list.m_lastLine = CurLineNumber();
+        }
             break;
 
         case T_target:
@@ -580,10 +599,170 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
         }
     }
 
+    parseItemLists( lists );
+    addItemLists( lists );
+
     return m_board;
 }
 
 
+void PCB_PARSER::parseItemLists( std::vector<BOARD_ITEM_LIST>& aLists )
+{
+    // Start with the biggest lists (usually the filled zones), so a big one picked
+    // up last does not keep a single thread busy while the others are idle
+    std::vector<size_t> order( aLists.size() );
+
+    for( size_t i = 0; i < order.size(); ++i )
+        order[i] = i;
+
+    std::stable_sort( order.begin(), order.end(),
+            [&aLists]( size_t a, size_t b )
+            {
+                return aLists[a].m_text.size() > aLists[b].m_text.size();
+            } );
+
+    const wxString      source = CurSource();
+    std::atomic<size_t> nextList( 0 );
+    std::atomic<bool>   failed( false );
+
+    auto worker = [&]()
+    {
+        // The board and its nets are only read here: the parsers must not modify them
+        PCB_PARSER parser;
+
+        parser.m_board             = m_board;
+        parser.m_layerIndices      = m_layerIndices;
+        parser.m_layerMasks        = m_layerMasks;
+        parser.m_netCodes          = m_netCodes;
+        parser.m_tooRecent         = m_tooRecent;
+        parser.m_requiredVersion   = m_requiredVersion;
+        parser.m_deferZoneNetFixes = true;
+
+        for( size_t i = nextList.fetch_add( 1 ); i < order.size() && !failed;
+                i = nextList.fetch_add( 1 ) )
+        {
+            BOARD_ITEM_LIST& list = aLists[ order[i] ];
+
+            try
+            {
+                STRING_LINE_READER reader( list.m_text, source, list.m_line - 1 );
+
+                parser.SetLineReader( &reader );
+
+                for( T token = parser.NextTok();  token != T_EOF;  token = parser.NextTok() )
+                {
+                    if( token != T_LEFT )
+                        parser.Expecting( T_LEFT );
+
+                    BOARD_ITEM* item = NULL;
+
+                    switch( parser.NextTok() )
+                    {
+                    case T_module:  item = parser.parseMODULE();          break;
+                    case T_segment: item = parser.parseTRACK();           break;
+                    case T_via:     item = parser.parseVIA();             break;
+                    case T_zone:    item = parser.parseZONE_CONTAINER();  break;
+                    default:        parser.Expecting( "module, segment, via or zone" );
+                    }
+
+                    list.m_items.emplace_back( item );
+                }
+
+                parser.PopReader();
+                list.m_zoneNetNames.swap( parser.m_zoneNetNames );
+
+                // Release the text now, it can be as big as the board file
+                std::string().swap( list.m_text );
+            }
+            catch( ... )
+            {
+                list.m_error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ), aLists.size() );
+
+    std::vector<std::thread> workers;
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        workers.push_back( std::thread( worker ) );
+
+    for( auto& thread : workers )
+        thread.join();
+
+    // Report the failing list closest to the start of the file
+    for( auto& list : aLists )
+    {
+        if( list.m_error )
+            std::rethrow_exception( list.m_error );
+    }
+}
+
+
+void PCB_PARSER::addItemLists( std::vector<BOARD_ITEM_LIST>& aLists )
+{
+    // Board net codes changed by the zone net fixes, applied to the items read after them
+    std::unordered_map<int, int> netRemap;
+
+    auto remap = [&netRemap]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        auto it = netRemap.find( aItem->GetNetCode() );
+
+        if( it != netRemap.end() )
+            aItem->SetNetCode( it->second, /* aNoAssert */ true );
+    };
+
+    for( auto& list : aLists )
+    {
+        for( auto& item : list.m_items )
+        {
+            if( netRemap.empty() )
+                break;
+
+            if( item->Type() == PCB_MODULE_T )
+            {
+                for( D_PAD* pad = static_cast<MODULE*>( item.get() )->PadsList(); pad;
+                        pad = pad->Next() )
+                    remap( pad );
+            }
+            else
+            {
+                remap( static_cast<BOARD_CONNECTED_ITEM*>( item.get() ) );
+            }
+        }
+
+        for( auto& zoneNet : list.m_zoneNetNames )
+        {
+            ZONE_CONTAINER* zone = zoneNet.first;
+
+            if( zone->GetNet()->GetNetname() == zoneNet.second )
+                continue;
+
+            std::vector<int> netCodes = m_netCodes;
+
+            fixZoneNet( zone, zoneNet.second );
+
+            for( size_t ii = 0; ii < m_netCodes.size(); ++ii )
+            {
+                // getNetCode() leaves the codes out of the table unchanged
+                int previous = ii < netCodes.size() ? netCodes[ii] : (int) ii;
+
+                if( m_netCodes[ii] != previous )
+                    netRemap[previous] = m_netCodes[ii];
+            }
+        }
+
+        bool isTrack = list.m_token == T_segment;
+
+        for( auto& item : list.m_items )
+            m_board->Add( item.release(), isTrack ? ADD_INSERT : ADD_APPEND );
+    }
+}
+
+
 void PCB_PARSER::parseHeader()
 {
     wxCHECK_RET( CurTok() == T_kicad_pcb,
@@ -3162,40 +3341,48 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER()
     if( !zone_has_net )
         zone->SetNetCode( NETINFO_LIST::UNCONNECTED );
 
-    // Ensure the zone net name is valid, and matches the net code, for copper zones
-    if( zone_has_net && ( zone->GetNet()->GetNetname() != netnameFromfile ) )
+    // Ensure the zone net name is valid, and matches the net code, for copper zones.
+    // Worker threads do not own the board, and their net code mapping can be out of
+    // date: the board parser checks the net name later, see addItemLists()
+    if( zone_has_net && m_deferZoneNetFixes )
+        m_zoneNetNames.emplace_back( zone.get(), netnameFromfile );
+    else if( zone_has_net && ( zone->GetNet()->GetNetname() != netnameFromfile ) )
+        fixZoneNet( zone.get(), netnameFromfile );
+
+    return zone.release();
+}
+
+
+void PCB_PARSER::fixZoneNet( ZONE_CONTAINER* aZone, const wxString& aNetName )
+{
+    // Can happens which old boards, with nonexistent nets ...
+    // or after being edited by hand
+    // We try to fix the mismatch.
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+        aZone->SetNetCode( net->GetNet() );
+    else    // Not existing net: add a new net to keep trace of the zone netname
     {
-        // Can happens which old boards, with nonexistent nets ...
-        // or after being edited by hand
-        // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net );
 
-        if( net )   // An existing net has the same net name. use it for the zone
-            zone->SetNetCode( net->GetNet() );
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNet() );
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNet() );
-
-            // FIXME: a call to any GUI item is not allowed in io plugins:
-            // Change this code to generate a warning message outside this plugin
-            // Prompt the user
-            wxString msg;
-            msg.Printf( _( "There is a zone that belongs to a not existing net\n"
-                           "\"%s\"\n"
-                           "you should verify and edit it (run DRC test)." ),
-                           GetChars( netnameFromfile ) );
-            DisplayError( NULL, msg );
-        }
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNet() );
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNet() );
+
+        // FIXME: a call to any GUI item is not allowed in io plugins:
+        // Change this code to generate a warning message outside this plugin
+        // Prompt the user
+        wxString msg;
+        msg.Printf( _( "There is a zone that belongs to a not existing net\n"
+                       "\"%s\"\n"
+                       "you should verify and edit it (run DRC test)." ),
+                       GetChars( aNetName ) );
+        DisplayError( NULL, msg );
     }
-
-    return zone.release();
 }
 
 
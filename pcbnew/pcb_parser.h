@@ -36,7 +36,10 @@
 #include <common.h>                             // KiROUND
 #include <convert_to_biu.h>                     // IU_PER_MM
 
+#include <exception>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 
 class BOARD;
@@ -64,6 +67,25 @@ struct LAYER;
  */
 class PCB_PARSER : public PCB_LEXER
 {
+    /**
+     * A module or a zone of a board, or a run of consecutive tracks and vias, copied as
+     * text while reading the board and parsed later in a worker thread.
+     */
+    struct BOARD_ITEM_LIST
+    {
+        PCB_KEYS_T::T                   m_token;    ///< T_module, T_zone or T_segment (tracks)
+        int                             m_line;     ///< line number of the list in the file
+        int                             m_lastLine; ///< line number of the end of the text
+        std::string                     m_text;     ///< the lists, from ReadRawList()
+        std::exception_ptr              m_error;    ///< the error thrown by the parser, if any
+
+        ///> the parsed items, in file order
+        std::vector< std::unique_ptr<BOARD_ITEM> > m_items;
+
+        ///> zones with a net name to check, see m_zoneNetNames
+        std::vector< std::pair<ZONE_CONTAINER*, wxString> > m_zoneNetNames;
+    };
+
     typedef std::unordered_map< std::string, PCB_LAYER_ID >   LAYER_ID_MAP;
     typedef std::unordered_map< std::string, LSET >       LSET_MAP;
 
@@ -74,6 +96,12 @@ class PCB_PARSER : public PCB_LEXER
     bool                m_tooRecent;        ///< true if version parses as later than supported
     int                 m_requiredVersion;  ///< set to the KiCad format version this board requires
 
+    ///> true when parsing board items in a worker thread, see parseBOARD_unchecked()
+    bool                m_deferZoneNetFixes;
+
+    ///> copper zones and the net name read for them, checked later by the board parser
+    std::vector< std::pair<ZONE_CONTAINER*, wxString> > m_zoneNetNames;
+
     ///> Converts net code using the mapping table if available,
     ///> otherwise returns unchanged net code if < 0 or if is is out of range
     inline int getNetCode( int aNetCode )
@@ -130,6 +158,14 @@ class PCB_PARSER : public PCB_LEXER
     TRACK*          parseTRACK();
     VIA*            parseVIA();
     ZONE_CONTAINER* parseZONE_CONTAINER();
+
+    /**
+     * Function fixZoneNet
+     * gives a zone whose net name does not match its net code the net with that name,
+     * creating it in the board if needed.
+     */
+    void            fixZoneNet( ZONE_CONTAINER* aZone, const wxString& aNetName );
+
     PCB_TARGET*     parsePCB_TARGET();
     BOARD*          parseBOARD();
 
@@ -139,6 +175,27 @@ class PCB_PARSER : public PCB_LEXER
      */
     BOARD*          parseBOARD_unchecked();
 
+    /**
+     * Function parseItemLists
+     * parses the board items copied by parseBOARD_unchecked(), using one parser per
+     * thread.
+     *
+     * @throw IO_ERROR, PARSE_ERROR: the error of the failing list closest to the start
+     *  of the file.
+     */
+    void            parseItemLists( std::vector<BOARD_ITEM_LIST>& aLists );
+
+    /**
+     * Function addItemLists
+     * adds the items parsed by parseItemLists() to the board, in file order, fixing the
+     * zone nets on the way as a serial load does.
+     *
+     * A zone with an unknown net name adds a net to the board, and can change the net
+     * code mapping for the items following it (see fixZoneNet()): the worker threads
+     * could not see that, so the net codes of these items are resolved again here.
+     */
+    void            addItemLists( std::vector<BOARD_ITEM_LIST>& aLists );
+
 
     /**
      * Function lookUpLayer
@@ -273,7 +330,8 @@ public:
 
     PCB_PARSER( LINE_READER* aReader = NULL ) :
         PCB_LEXER( aReader ),
-        m_board( 0 )
+        m_board( 0 ),
+        m_deferZoneNetFixes( false )
     {
         init();
     }
@@ -679,7 +679,7 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter,
         outlines.RemoveAllContours();
         aBoard->ConvertBrdLayerToPolygonalContours( layer, outlines );
 
-        outlines.Simplify( SHAPE_POLY_SET::PM_FAST );
+        outlines.SimplifyParallel( SHAPE_POLY_SET::PM_FAST );
 
         // Plot outlines
         std::vector< wxPoint > cornerList;
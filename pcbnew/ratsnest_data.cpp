@@ -32,9 +32,7 @@
 #include <omp.h>
 #endif /* USE_OPENMP */
 
-#ifdef PROFILE
 #include <profile.h>
-#endif
 
 #include <ratsnest_data.h>
 #include <functional>
@@ -73,14 +71,14 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
     // The output
     std::vector<CN_EDGE> mst;
 
-    // Set tags for marking cycles
-    std::unordered_map<CN_ANCHOR_PTR, int> tags;
-    unsigned int tag = 0;
+    // Node tags are set to the node index, and tags[] gives the subtree of each node
+    // (used for marking cycles)
+    std::vector<int> tags( nodeNumber );
 
-    for( auto& node : aNodes )
+    for( unsigned int i = 0; i < nodeNumber; ++i )
     {
-        node->SetTag( tag );
-        tags[node] = tag++;
+        aNodes[i]->SetTag( i );
+        tags[i] = i;
     }
 
     // Lists of nodes connected together (subtrees) to detect cycles in the graph
@@ -97,8 +95,8 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
         //printf("mstSize %d %d\n", mstSize, mstExpectedSize);
         auto& dt = aEdges.front();
 
-        int srcTag  = tags[dt.GetSourceNode()];
-        int trgTag  = tags[dt.GetTargetNode()];
+        int srcTag  = tags[dt.GetSourceNode()->GetTag()];
+        int trgTag  = tags[dt.GetTargetNode()->GetTag()];
 
         // Check if by adding this edge we are going to join two different forests
         if( srcTag != trgTag )
@@ -114,7 +112,7 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
             {
                 for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
                 {
-                    tags[aNodes[*it]] = srcTag;
+                    tags[*it] = srcTag;
                 }
 
                 // Do a copy of edge, but make it RN_EDGE_MST. In contrary to RN_EDGE,
@@ -122,7 +120,6 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
                 // edges to exist for getting source/target nodes
                 CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(), dt.GetWeight() );
 
-                assert( newEdge.GetSourceNode()->GetTag() != newEdge.GetTargetNode()->GetTag() );
                 assert( newEdge.GetWeight() > 0 );
 
                 mst.push_back( newEdge );
@@ -134,8 +131,7 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
                 // for( auto it : cycles[trgTag] )
                 for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
                 {
-                    tags[aNodes[*it]] = srcTag;
-                    aNodes[*it]->SetTag( srcTag );
+                    tags[*it] = srcTag;
                 }
 
                 // Processing a connection, decrease the expected size of the ratsnest MST
@@ -160,7 +156,11 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
 class RN_NET::TRIANGULATOR_STATE
 {
 private:
+    using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
+
     std::vector<CN_ANCHOR_PTR>  m_allNodes;
+    std::vector<hed::NODE_PTR>  m_triNodes;
+    std::vector<ANCHOR_LIST>    m_anchorChains;     ///< anchors sharing a triangulation node
 
     std::list<hed::EDGE_PTR> hedTriangulation( std::vector<hed::NODE_PTR>& aNodes )
     {
@@ -208,7 +208,7 @@ public:
         m_allNodes.clear();
     }
 
-    void AddNode( CN_ANCHOR_PTR aNode )
+    void AddNode( const CN_ANCHOR_PTR& aNode )
     {
         m_allNodes.push_back( aNode );
     }
@@ -217,13 +217,17 @@ public:
     {
         std::list<CN_EDGE> mstEdges;
         std::list<hed::EDGE_PTR> triangEdges;
-        std::vector<hed::NODE_PTR> triNodes;
 
-        using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
-        std::vector<ANCHOR_LIST> anchorChains;
+        // The buffers of the previous update of this net are reused: during a drag,
+        // the same nets are recomputed over and over
+        m_triNodes.clear();
+        m_triNodes.reserve( m_allNodes.size() );
+
+        for( auto& chain : m_anchorChains )
+            chain.clear();
 
-        triNodes.reserve( m_allNodes.size() );
-        anchorChains.reserve( m_allNodes.size() );
+        if( m_anchorChains.size() < m_allNodes.size() )
+            m_anchorChains.resize( m_allNodes.size() );
 
         std::sort( m_allNodes.begin(), m_allNodes.end(),
                 [] ( const CN_ANCHOR_PTR& aNode1, const CN_ANCHOR_PTR& aNode2 )
@@ -242,19 +246,14 @@ public:
         CN_ANCHOR_PTR prev, last;
         int id = 0;
 
-        for( auto n : m_allNodes )
-        {
-            anchorChains.push_back( ANCHOR_LIST() );
-        }
-
-        for( auto n : m_allNodes )
+        for( const auto& n : m_allNodes )
         {
             if( !prev || prev->Pos() != n->Pos() )
             {
                 auto tn = std::make_shared<hed::NODE> ( n->Pos().x, n->Pos().y );
 
                 tn->SetId( id );
-                triNodes.push_back( tn );
+                m_triNodes.push_back( tn );
             }
 
             id++;
@@ -263,37 +262,37 @@ public:
 
         int prevId = 0;
 
-        for( auto n : triNodes )
+        for( const auto& n : m_triNodes )
         {
             for( int i = prevId; i < n->Id(); i++ )
-                anchorChains[prevId].push_back( m_allNodes[ i ] );
+                m_anchorChains[prevId].push_back( m_allNodes[ i ] );
 
             prevId = n->Id();
         }
 
         for( int i = prevId; i < id; i++ )
-            anchorChains[prevId].push_back( m_allNodes[ i ] );
+            m_anchorChains[prevId].push_back( m_allNodes[ i ] );
 
-        if( triNodes.size() == 1 )
+        if( m_triNodes.size() == 1 )
         {
             return mstEdges;
         }
-        else if( areNodesColinear( triNodes ) )
+        else if( areNodesColinear( m_triNodes ) )
         {
             // special case: all nodes are on the same line - there's no
             // triangulation for such set. In this case, we sort along any coordinate
             // and chain the nodes together.
-            for(int i = 0; i < (int)triNodes.size() - 1; i++ )
+            for(int i = 0; i < (int)m_triNodes.size() - 1; i++ )
             {
-                auto src = m_allNodes[ triNodes[i]->Id() ];
-                auto dst = m_allNodes[ triNodes[i + 1]->Id() ];
+                auto src = m_allNodes[ m_triNodes[i]->Id() ];
+                auto dst = m_allNodes[ m_triNodes[i + 1]->Id() ];
                 mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
             }
         }
         else
         {
             hed::TRIANGULATION triangulator;
-            triangulator.CreateDelaunay( triNodes.begin(), triNodes.end() );
+            triangulator.CreateDelaunay( m_triNodes.begin(), m_triNodes.end() );
             triangulator.GetEdges( triangEdges );
 
             for( auto e : triangEdges )
@@ -305,16 +304,16 @@ public:
             }
         }
 
-        for( unsigned int i = 0; i < anchorChains.size(); i++ )
+        for( unsigned int i = 0; i < m_anchorChains.size(); i++ )
         {
-            auto& chain = anchorChains[i];
+            auto& chain = m_anchorChains[i];
 
             if( chain.size() < 2 )
                 continue;
 
             std::sort( chain.begin(), chain.end(),
                     [] ( const CN_ANCHOR_PTR& a, const CN_ANCHOR_PTR& b ) {
-                return a->GetCluster().get() < b->GetCluster().get();
+                return a->GetCluster() < b->GetCluster();
             } );
 
             for( unsigned int j = 1; j < chain.size(); j++ )
@@ -326,17 +325,29 @@ public:
             }
         }
 
+        // Release the triangulation nodes and anchors, but keep the buffers
+        m_triNodes.clear();
+
+        for( auto& chain : m_anchorChains )
+            chain.clear();
+
         return mstEdges;
     }
 };
 
 
-RN_NET::RN_NET() : m_dirty( true )
+RN_NET::RN_NET() : m_dirty( true ), m_updateTime( 0.0 )
 {
     m_triangulator.reset( new TRIANGULATOR_STATE );
 }
 
 
+RN_NET::~RN_NET()
+{
+    Clear();
+}
+
+
 void RN_NET::compute()
 {
     // Special cases do not need complicated algorithms (actually, it does not work well with
@@ -361,7 +372,7 @@ void RN_NET::compute()
         else
         {
             // Set tags to m_nodes as connected
-            for( auto node : m_nodes )
+            for( const auto& node : m_nodes )
                 node->SetTag( 0 );
         }
 
@@ -371,7 +382,7 @@ void RN_NET::compute()
 
     m_triangulator->Clear();
 
-    for( auto n : m_nodes )
+    for( const auto& n : m_nodes )
     {
         m_triangulator->AddNode( n );
     }
@@ -401,17 +412,25 @@ void RN_NET::compute()
 
 void RN_NET::Update()
 {
+    PROF_COUNTER timer;
+
     compute();
 
+    m_updateTime = timer.msecs();
     m_dirty = false;
 }
 
 
 void RN_NET::Clear()
 {
+    // The clusters are released below, do not leave dangling references to them
+    for( const auto& node : m_nodes )
+        node->SetCluster( nullptr );
+
     m_rnEdges.clear();
     m_boardEdges.clear();
     m_nodes.clear();
+    m_clusters.clear();
 
     m_dirty = true;
 }
@@ -421,6 +440,8 @@ void RN_NET::AddCluster( CN_CLUSTER_PTR aCluster )
 {
     CN_ANCHOR_PTR firstAnchor;
 
+    m_clusters.push_back( aCluster );
+
     for( auto item : *aCluster )
     {
         bool isZone = dynamic_cast<CN_ZONE*>(item) != nullptr;
@@ -437,7 +458,7 @@ void RN_NET::AddCluster( CN_CLUSTER_PTR aCluster )
         {
         //    printf("add anchor %p\n", anchors[i].get() );
 
-            anchors[i]->SetCluster( aCluster );
+            anchors[i]->SetCluster( aCluster.get() );
             m_nodes.push_back(anchors[i]);
 
             if( firstAnchor )
@@ -463,21 +484,21 @@ bool RN_NET::NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode
 
     VECTOR2I::extended_type distMax = VECTOR2I::ECOORD_MAX;
 
-    for( auto nodeA : m_nodes )
+    for( const auto& nodeA : m_nodes )
     {
-        for( auto nodeB : aOtherNet.m_nodes )
+        if( nodeA->GetNoLine() )
+            continue;
+
+        for( const auto& nodeB : aOtherNet.m_nodes )
         {
-            if( !nodeA->GetNoLine() )
-            {
-                auto squaredDist = (nodeA->Pos() - nodeB->Pos() ).SquaredEuclideanNorm();
+            auto squaredDist = (nodeA->Pos() - nodeB->Pos() ).SquaredEuclideanNorm();
 
-                if( squaredDist < distMax )
-                {
-                    rv = true;
-                    distMax = squaredDist;
-                    aNode1  = nodeA;
-                    aNode2  = nodeB;
-                }
+            if( squaredDist < distMax )
+            {
+                rv = true;
+                distMax = squaredDist;
+                aNode1  = nodeA;
+                aNode2  = nodeB;
             }
         }
     }
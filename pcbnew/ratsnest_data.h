@@ -61,6 +61,7 @@ class RN_NET
 public:
     ///> Default constructor.
     RN_NET();
+    ~RN_NET();
 
     /**
      * Function SetVisible()
@@ -95,7 +96,7 @@ public:
      * Returns pointer to a vector of edges that makes ratsnest for a given net.
      * @return Pointer to a vector of edges that makes ratsnest for a given net.
      */
-    const std::vector<CN_EDGE> GetUnconnected() const
+    const std::vector<CN_EDGE>& GetUnconnected() const
     {
         return m_rnEdges;
     }
@@ -107,6 +108,15 @@ public:
     void Update();
     void Clear();
 
+    /**
+     * Function GetUpdateTime()
+     * @return the time spent in the last Update() of the net, in milliseconds.
+     */
+    double GetUpdateTime() const
+    {
+        return m_updateTime;
+    }
+
     void AddCluster( std::shared_ptr<CN_CLUSTER> aCluster );
 
     unsigned int GetNodeCount() const
@@ -151,6 +161,9 @@ protected:
     ///> Vector of nodes
     std::vector<CN_ANCHOR_PTR> m_nodes;
 
+    ///> Clusters of the net, referred to by the nodes
+    std::vector<std::shared_ptr<CN_CLUSTER>> m_clusters;
+
     ///> Vector of edges that make pre-defined connections
     std::vector<CN_EDGE> m_boardEdges;
 
@@ -160,6 +173,9 @@ protected:
     ///> Flag indicating necessity of recalculation of ratsnest for a net.
     bool m_dirty;
 
+    ///> Duration of the last update, in milliseconds.
+    double m_updateTime;
+
     class TRIANGULATOR_STATE;
 
     std::shared_ptr<TRIANGULATOR_STATE> m_triangulator;
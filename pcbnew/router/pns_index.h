@@ -113,6 +113,14 @@ public:
      */
     void Clear();
 
+    /**
+     * Function Reset()
+     *
+     * Removes all items from the index, but keeps the subindices and the hash
+     * buckets allocated, so the index can be reused by another branch.
+     */
+    void Reset();
+
     /**
      * Function GetItemsForNet()
      *
@@ -315,6 +323,18 @@ void INDEX::Clear()
     }
 }
 
+void INDEX::Reset()
+{
+    for( int i = 0; i < MaxSubIndices; ++i )
+    {
+        if( m_subIndices[i] )
+            m_subIndices[i]->RemoveAll();
+    }
+
+    m_netMap.clear();
+    m_allItems.clear();
+}
+
 INDEX::~INDEX()
 {
     Clear();
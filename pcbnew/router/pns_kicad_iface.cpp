@@ -436,6 +436,9 @@ public:
 
     void AddLine( const SHAPE_LINE_CHAIN& aLine, int aType, int aWidth ) override
     {
+        if( !m_view )
+            return;
+
         ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( NULL, m_view );
 
         pitem->Line( aLine, aWidth, aType );
@@ -989,7 +992,7 @@ void PNS_KICAD_IFACE::EraseView()
 
     m_hiddenItems.clear();
 
-    if( m_previewItems )
+    if( m_view && m_previewItems )
     {
         m_previewItems->FreeItems();
         m_view->Update( m_previewItems );
@@ -1004,6 +1007,9 @@ void PNS_KICAD_IFACE::DisplayItem( const PNS::ITEM* aItem, int aColor, int aClea
 {
     wxLogTrace( "PNS", "DisplayItem %p", aItem );
 
+    if( !m_view )
+        return;
+
     ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( aItem, m_view );
 
     if( aColor >= 0 )
@@ -1032,7 +1038,7 @@ void PNS_KICAD_IFACE::HideItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* parent = aItem->Parent();
 
-    if( parent )
+    if( parent && m_view )
     {
         if( m_view->IsVisible( parent ) )
             m_hiddenItems.insert( parent );
@@ -1047,7 +1053,7 @@ void PNS_KICAD_IFACE::RemoveItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* parent = aItem->Parent();
 
-    if( parent )
+    if( parent && m_commit )
     {
         m_commit->Remove( parent );
     }
@@ -1058,6 +1064,10 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* newBI = NULL;
 
+    // Without a host tool, the changes stay in the router world
+    if( !m_commit )
+        return;
+
     switch( aItem->Kind() )
     {
     case PNS::ITEM::SEGMENT_T:
@@ -1106,6 +1116,10 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 void PNS_KICAD_IFACE::Commit()
 {
     EraseView();
+
+    if( !m_commit )
+        return;
+
     m_commit->Push( _( "Added a track" ) );
     m_commit.reset( new BOARD_COMMIT( m_tool ) );
 }
@@ -1122,9 +1136,15 @@ void PNS_KICAD_IFACE::SetView( KIGFX::VIEW* aView )
     }
 
     m_view = aView;
-    m_previewItems = new KIGFX::VIEW_GROUP( m_view );
-    m_previewItems->SetLayer( LAYER_GP_OVERLAY ) ;
-    m_view->Add( m_previewItems );
+    m_previewItems = nullptr;
+
+    // A null view runs the router without displaying anything, e.g. to replay a session
+    if( m_view )
+    {
+        m_previewItems = new KIGFX::VIEW_GROUP( m_view );
+        m_previewItems->SetLayer( LAYER_GP_OVERLAY ) ;
+        m_view->Add( m_previewItems );
+    }
 
     delete m_debugDecorator;
     m_debugDecorator = new PNS_PCBNEW_DEBUG_DECORATOR();
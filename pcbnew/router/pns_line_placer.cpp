@@ -417,7 +417,7 @@ bool LINE_PLACER::rhMarkObstacles( const VECTOR2I& aP, LINE& aNewHead )
     if( obs )
     {
         int cl = m_currentNode->GetClearance( obs->m_item, &m_head );
-        auto hull = obs->m_item->Hull( cl, m_head.Width() );
+        auto hull = m_currentNode->CachedHull( obs->m_item, cl, m_head.Width() );
 
         auto nearest = hull.NearestPoint( aP );
         Dbg()->AddLine( hull, 2, 10000 );
@@ -49,6 +49,7 @@ void LOGGER::Clear()
 {
     m_theLog.str( std::string() );
     m_groupOpened = false;
+    m_events.clear();
 }
 
 
@@ -205,4 +206,54 @@ void LOGGER::Save( const std::string& aFilename )
     fclose( f );
 }
 
+
+bool LOGGER::SaveEvents( const std::string& aFilename ) const
+{
+    FILE* f = fopen( aFilename.c_str(), "wb" );
+
+    wxLogTrace( "PNS", "Saving %d events to '%s' [%p]", (int) m_events.size(),
+                aFilename.c_str(), f );
+
+    if( !f )
+        return false;
+
+    for( const EVENT_ENTRY& evt : m_events )
+    {
+        fprintf( f, "event %d %d %d %d %d %d %d %d %d %d %d %d %d\n", (int) evt.type,
+                 evt.p.x, evt.p.y, evt.arg, evt.itemKind, evt.itemNet, evt.itemLayerStart,
+                 evt.itemLayerEnd, evt.routerMode, evt.routingMode, evt.trackWidth,
+                 evt.viaDiameter, evt.viaDrill );
+    }
+
+    fclose( f );
+
+    return true;
+}
+
+
+bool LOGGER::LoadEvents( const std::string& aFilename, std::vector<EVENT_ENTRY>& aEvents )
+{
+    FILE* f = fopen( aFilename.c_str(), "rb" );
+
+    if( !f )
+        return false;
+
+    EVENT_ENTRY evt;
+    int type;
+
+    while( fscanf( f, " event %d %d %d %d %d %d %d %d %d %d %d %d %d", &type,
+                   &evt.p.x, &evt.p.y, &evt.arg, &evt.itemKind, &evt.itemNet,
+                   &evt.itemLayerStart, &evt.itemLayerEnd, &evt.routerMode,
+                   &evt.routingMode, &evt.trackWidth, &evt.viaDiameter, &evt.viaDrill ) == 13 )
+    {
+        evt.type = (EVENT_TYPE) type;
+        aEvents.push_back( evt );
+    }
+
+    bool ok = feof( f );
+    fclose( f );
+
+    return ok;
+}
+
 }
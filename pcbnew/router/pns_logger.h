@@ -39,12 +39,68 @@ class ITEM;
 class LOGGER
 {
 public:
+    ///> Router calls recorded by LogEvent(), to replay an interactive session
+    enum EVENT_TYPE
+    {
+        EVT_START_ROUTE = 0,
+        EVT_START_DRAG,
+        EVT_MOVE,
+        EVT_FIX,
+        EVT_STOP
+    };
+
+    struct EVENT_ENTRY
+    {
+        EVENT_TYPE  type;
+        VECTOR2I    p;
+        int         arg;            ///< layer (start route), drag mode (start drag),
+                                    ///< force finish flag (fix)
+
+        // The item passed to the router, found again by its kind, net and layers
+        // among the items under p when replaying
+        int         itemKind;       ///< 0 when there is no item
+        int         itemNet;
+        int         itemLayerStart;
+        int         itemLayerEnd;
+
+        // Router setup, for the start events
+        int         routerMode;     ///< ROUTER_MODE
+        int         routingMode;    ///< PNS_MODE: shove, walkaround...
+        int         trackWidth;
+        int         viaDiameter;
+        int         viaDrill;
+    };
+
     LOGGER();
     ~LOGGER();
 
     void Save( const std::string& aFilename );
     void Clear();
 
+    void LogEvent( const EVENT_ENTRY& aEvent )
+    {
+        m_events.push_back( aEvent );
+    }
+
+    const std::vector<EVENT_ENTRY>& GetEvents() const
+    {
+        return m_events;
+    }
+
+    /**
+     * Function SaveEvents
+     * writes the recorded events as text, one per line.
+     * @return false if the file cannot be written.
+     */
+    bool SaveEvents( const std::string& aFilename ) const;
+
+    /**
+     * Function LoadEvents
+     * reads events written by SaveEvents().
+     * @return false if the file cannot be read.
+     */
+    static bool LoadEvents( const std::string& aFilename, std::vector<EVENT_ENTRY>& aEvents );
+
     void NewGroup( const std::string& aName, int aIter = 0 );
     void EndGroup();
 
@@ -58,6 +114,7 @@ private:
 
     bool m_groupOpened;
     std::stringstream m_theLog;
+    std::vector<EVENT_ENTRY> m_events;
 };
 
 }
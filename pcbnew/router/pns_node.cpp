@@ -45,7 +45,16 @@ namespace PNS {
 static std::unordered_set<NODE*> allocNodes;
 #endif
 
-NODE::NODE()
+///> maximum number of deleted branches the root keeps around for reuse
+static const unsigned int MaxSpareBranches = 16;
+
+NODE::NODE() :
+    NODE( new INDEX )
+{
+}
+
+
+NODE::NODE( INDEX* aIndex )
 {
     wxLogTrace( "PNS", "NODE::create %p", this );
     m_depth = 0;
@@ -53,7 +62,7 @@ NODE::NODE()
     m_parent = NULL;
     m_maxClearance = 800000;    // fixme: depends on how thick traces are.
     m_ruleResolver = NULL;
-    m_index = new INDEX;
+    m_index = aIndex;
 
 #ifdef DEBUG
     allocNodes.insert( this );
@@ -81,8 +90,6 @@ NODE::~NODE()
     allocNodes.erase( this );
 #endif
 
-    m_joints.clear();
-
     for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
     {
         if( (*i)->BelongsTo( this ) )
@@ -92,7 +99,30 @@ NODE::~NODE()
     releaseGarbage();
     unlinkParent();
 
-    delete m_index;
+    if( isRoot() )
+    {
+        for( BRANCH_STORAGE& spare : m_spareBranches )
+            delete spare.m_index;
+
+        delete m_index;
+    }
+    else if( m_root->m_spareBranches.size() < MaxSpareBranches )
+    {
+        // Branches are created and deleted on every mouse move. Hand the containers
+        // over to the root, so the next Branch() call reuses the index with its
+        // subindices and the hash bucket arrays of the index, joint map and overrides.
+        m_index->Reset();
+        m_root->m_spareBranches.emplace_back();
+
+        BRANCH_STORAGE& spare = m_root->m_spareBranches.back();
+        spare.m_index = m_index;
+        spare.m_joints.swap( m_joints );
+        spare.m_override.swap( m_override );
+    }
+    else
+    {
+        delete m_index;
+    }
 }
 
 int NODE::GetClearance( const ITEM* aA, const ITEM* aB ) const
@@ -106,7 +136,20 @@ int NODE::GetClearance( const ITEM* aA, const ITEM* aB ) const
 
 NODE* NODE::Branch()
 {
-    NODE* child = new NODE;
+    NODE* child;
+    std::vector<BRANCH_STORAGE>& spares = m_root->m_spareBranches;
+
+    if( spares.empty() )
+    {
+        child = new NODE;
+    }
+    else
+    {
+        child = new NODE( spares.back().m_index );
+        child->m_joints.swap( spares.back().m_joints );
+        child->m_override.swap( spares.back().m_override );
+        spares.pop_back();
+    }
 
     wxLogTrace( "PNS", "NODE::branch %p (parent %p)", child, this );
 
@@ -119,17 +162,20 @@ NODE* NODE::Branch()
 
     // immmediate offspring of the root branch needs not copy anything.
     // For the rest, deep-copy joints, overridden item map and pointers
-    // to stored items.
+    // to stored items. Assigning to the recycled containers reuses their nodes.
     if( !isRoot() )
     {
-        JOINT_MAP::iterator j;
-
         for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
             child->m_index->Add( *i );
 
         child->m_joints = m_joints;
         child->m_override = m_override;
     }
+    else
+    {
+        child->m_joints.clear();
+        child->m_override.clear();
+    }
 
     wxLogTrace( "PNS", "%d items, %d joints, %d overrides",
             child->m_index->Size(), (int) child->m_joints.size(), (int) child->m_override.size() );
@@ -341,7 +387,7 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aItem, int aKindMask,
 
         int clearance = GetClearance( obs.m_item, &aLine );
 
-        SHAPE_LINE_CHAIN hull = obs.m_item->Hull( clearance, aItem->Width() );
+        SHAPE_LINE_CHAIN hull = CachedHull( obs.m_item, clearance, aItem->Width() );
 
         if( aLine.EndsWithVia() )
         {
@@ -649,12 +695,55 @@ void NODE::doRemove( ITEM* aItem )
     // the item belongs to this particular branch: un-reference it
     if( aItem->BelongsTo( this ) )
     {
+        {
+            std::lock_guard<std::mutex> lock( m_hullCacheLock );
+            m_hullCache.erase( aItem );
+        }
+
         aItem->SetOwner( NULL );
         m_root->m_garbageItems.insert( aItem );
     }
 }
 
 
+const SHAPE_LINE_CHAIN NODE::CachedHull( const ITEM* aItem, int aClearance,
+                                         int aWalkaroundThickness ) const
+{
+    const NODE* owner = aItem->Owner();
+
+    // items outside the world (e.g. the line being routed) are not cached
+    if( !owner )
+        return aItem->Hull( aClearance, aWalkaroundThickness );
+
+    if( owner != this )
+        return owner->CachedHull( aItem, aClearance, aWalkaroundThickness );
+
+    {
+        std::lock_guard<std::mutex> lock( m_hullCacheLock );
+        auto range = m_hullCache.equal_range( aItem );
+
+        for( auto i = range.first; i != range.second; ++i )
+        {
+            if( i->second.m_clearance == aClearance
+                    && i->second.m_walkaroundThickness == aWalkaroundThickness )
+                return i->second.m_hull;
+        }
+    }
+
+    // build the hull outside of the lock, walkarounds may query the node in parallel
+    HULL_CACHE_ENTRY ent;
+
+    ent.m_clearance = aClearance;
+    ent.m_walkaroundThickness = aWalkaroundThickness;
+    ent.m_hull = aItem->Hull( aClearance, aWalkaroundThickness );
+
+    std::lock_guard<std::mutex> lock( m_hullCacheLock );
+    m_hullCache.emplace( aItem, ent );
+
+    return ent.m_hull;
+}
+
+
 void NODE::removeSegmentIndex( SEGMENT* aSeg )
 {
     unlinkJoint( aSeg->Seg().A, aSeg->Layers(), aSeg->Net(), aSeg );
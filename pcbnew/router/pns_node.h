@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <list>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -256,6 +257,30 @@ public:
                          int            aKindMask = ITEM::ANY_T,
                          int            aForceClearance = -1 );
 
+    /**
+     * Function CachedHull()
+     *
+     * Returns the walkaround hull of an item stored in the world. Hulls are kept by the
+     * node owning the item, keyed by item, clearance and walkaround thickness, so the
+     * shove and walkaround iterations do not rebuild the hulls of the same obstacles over
+     * and over. An entry is dropped when its item is removed from its node, which covers
+     * Replace() and Commit(); the entries of a branch go away with the branch.
+     *
+     * Only hulls are cached, not collision results: the collision queries test the lines
+     * being shoved or optimized, which are temporary objects rebuilt at every iteration,
+     * so a result keyed by item would never be hit again (and the address of a temporary
+     * may be reused by the next one). The hull of a world obstacle is the expensive part
+     * that does repeat.
+     *
+     * Safe to call from several threads.
+     * @param aItem the item
+     * @param aClearance clearance of the hull
+     * @param aWalkaroundThickness width of the line walking around the item
+     * @return the hull
+     */
+    const SHAPE_LINE_CHAIN CachedHull( const ITEM* aItem, int aClearance,
+                                       int aWalkaroundThickness ) const;
+
     /**
      * Function HitTest()
      *
@@ -423,6 +448,9 @@ private:
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
 
+    ///> creates a node using an existing (empty) index
+    NODE( INDEX* aIndex );
+
     /// nodes are not copyable
     NODE( const NODE& aB );
     NODE& operator=( const NODE& aB );
@@ -501,6 +529,31 @@ private:
     int m_depth;
 
     std::unordered_set<ITEM*> m_garbageItems;
+
+    struct HULL_CACHE_ENTRY
+    {
+        int m_clearance;
+        int m_walkaroundThickness;
+        SHAPE_LINE_CHAIN m_hull;
+    };
+
+    ///> hulls of the items owned by this node, see CachedHull()
+    mutable std::unordered_multimap<const ITEM*, HULL_CACHE_ENTRY> m_hullCache;
+    mutable std::mutex m_hullCacheLock;
+
+    ///> containers of a deleted branch, kept by the root node so that the next
+    ///> Branch() call can reuse their hash bucket arrays, nodes and R-tree objects.
+    ///> The items cloned into a branch are not pooled: they are still allocated one
+    ///> by one, since Commit() hands them over to the root.
+    struct BRANCH_STORAGE
+    {
+        INDEX* m_index;
+        JOINT_MAP m_joints;
+        std::unordered_set<ITEM*> m_override;
+    };
+
+    ///> storage of the deleted branches (root node only)
+    std::vector<BRANCH_STORAGE> m_spareBranches;
 };
 
 }
@@ -126,6 +126,7 @@ const ITEM_SET ROUTER::QueryHoverItems( const VECTOR2I& aP )
 
 bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem, int aDragMode )
 {
+    logEvent( LOGGER::EVT_START_DRAG, aP, aStartItem, aDragMode );
 
     if( aDragMode & DM_FREE_ANGLE )
         m_forceMarkObstaclesMode = true;
@@ -169,6 +170,7 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, int aLayer )
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    logEvent( LOGGER::EVT_START_ROUTE, aP, aStartItem, aLayer );
 
     if( ! isStartingPointRoutable( aP, aLayer ) )
     {
@@ -224,6 +226,8 @@ void ROUTER::DisplayItems( const ITEM_SET& aItems )
 
 void ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    logEvent( LOGGER::EVT_MOVE, aP, endItem );
+
     m_currentEnd = aP;
 
     switch( m_state )
@@ -365,6 +369,8 @@ bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish )
 {
     bool rv = false;
 
+    logEvent( LOGGER::EVT_FIX, aP, aEndItem, aForceFinish );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -388,6 +394,8 @@ bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish )
 
 void ROUTER::StopRouting()
 {
+    logEvent( LOGGER::EVT_STOP, m_currentEnd, nullptr );
+
     // Update the ratsnest with new changes
 
     if( m_placer )
@@ -486,6 +494,43 @@ void ROUTER::DumpLog()
 }
 
 
+void ROUTER::StartRecording()
+{
+    m_eventLogger.reset( new LOGGER );
+}
+
+
+void ROUTER::StopRecording()
+{
+    m_eventLogger.reset();
+}
+
+
+void ROUTER::logEvent( LOGGER::EVENT_TYPE aType, const VECTOR2I& aP, const ITEM* aItem,
+                       int aArg )
+{
+    if( !m_eventLogger )
+        return;
+
+    LOGGER::EVENT_ENTRY evt;
+
+    evt.type            = aType;
+    evt.p               = aP;
+    evt.arg             = aArg;
+    evt.itemKind        = aItem ? aItem->Kind() : 0;
+    evt.itemNet         = aItem ? aItem->Net() : 0;
+    evt.itemLayerStart  = aItem ? aItem->Layers().Start() : 0;
+    evt.itemLayerEnd    = aItem ? aItem->Layers().End() : 0;
+    evt.routerMode      = m_mode;
+    evt.routingMode     = m_settings.Mode();
+    evt.trackWidth      = m_sizes.TrackWidth();
+    evt.viaDiameter     = m_sizes.ViaDiameter();
+    evt.viaDrill        = m_sizes.ViaDrill();
+
+    m_eventLogger->LogEvent( evt );
+}
+
+
 bool ROUTER::IsPlacingVia() const
 {
     if( !m_placer )
@@ -35,6 +35,8 @@
 #include "pns_item.h"
 #include "pns_itemset.h"
 #include "pns_node.h"
+#include "pns_logger.h"
+#include "pns_worker.h"
 
 namespace KIGFX
 {
@@ -160,6 +162,20 @@ public:
 
     void DumpLog();
 
+    /**
+     * Starts recording the StartRouting(), StartDragging(), Move(), FixRoute() and
+     * StopRouting() calls, so an interactive session can be replayed without the editor
+     * (see qa/pns_replay).  Previously recorded events are discarded.
+     */
+    void StartRecording();
+    void StopRecording();
+
+    ///> The recorded events, or nullptr when not recording
+    LOGGER* EventLogger() const
+    {
+        return m_eventLogger.get();
+    }
+
     RULE_RESOLVER* GetRuleResolver() const
     {
         return m_iface->GetRuleResolver();
@@ -215,6 +231,9 @@ public:
 
     PLACEMENT_ALGO* Placer() { return m_placer.get(); }
 
+    ///> Background thread shared by the algorithms, e.g. for the second walkaround direction
+    WORKER& Worker() { return m_worker; }
+
     ROUTER_IFACE* GetInterface() const
     {
         return m_iface;
@@ -246,6 +265,8 @@ private:
 
     void markViolations( NODE* aNode, ITEM_SET& aCurrent, NODE::ITEM_VECTOR& aRemoved );
     bool isStartingPointRoutable( const VECTOR2I& aWhere, int aLayer );
+    void logEvent( LOGGER::EVENT_TYPE aType, const VECTOR2I& aP, const ITEM* aItem,
+                   int aArg = 0 );
 
     VECTOR2I m_currentEnd;
     RouterState m_state;
@@ -256,6 +277,7 @@ private:
     std::unique_ptr< PLACEMENT_ALGO > m_placer;
     std::unique_ptr< DRAGGER >        m_dragger;
     std::unique_ptr< SHOVE >          m_shove;
+    std::unique_ptr< LOGGER >         m_eventLogger;
 
     ROUTER_IFACE* m_iface;
 
@@ -271,6 +293,8 @@ private:
 
     wxString m_toolStatusbarName;
     wxString m_failureReason;
+
+    WORKER m_worker;
 };
 
 }
@@ -32,6 +32,8 @@ using namespace std::placeholders;
 #include <macros.h>
 #include <pcbnew_id.h>
 #include <view/view_controls.h>
+#include <io_mgr.h>
+#include <kicad_plugin.h>
 #include <pcb_painter.h>
 #include <dialogs/dialog_pns_settings.h>
 #include <dialogs/dialog_pns_diff_pair_dimensions.h>
@@ -109,6 +111,41 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
 }
 
 
+void TOOL_BASE::startRecording()
+{
+    wxString name;
+
+    if( !wxGetEnv( wxT( "KICAD_PNS_RECORD" ), &name ) || name.IsEmpty() )
+        return;
+
+    try
+    {
+        PLUGIN::RELEASER pi( new PCB_IO );
+        pi->Save( name + wxT( ".kicad_pcb" ), board() );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( "PNS", "Cannot save the board to record the session: %s",
+                    GetChars( ioe.What() ) );
+        return;
+    }
+
+    m_router->StartRecording();
+}
+
+
+void TOOL_BASE::saveRecording()
+{
+    wxString name;
+
+    if( !m_router->EventLogger() || !wxGetEnv( wxT( "KICAD_PNS_RECORD" ), &name ) )
+        return;
+
+    m_router->EventLogger()->SaveEvents( std::string( ( name + wxT( ".events" ) ).mb_str() ) );
+    m_router->StopRecording();
+}
+
+
 ITEM* TOOL_BASE::pickSingleItem( const VECTOR2I& aWhere, int aNet, int aLayer, bool aIgnorePads )
 {
     int tl = getView()->GetTopLayer();
@@ -61,6 +61,14 @@ protected:
     virtual void updateEndItem( const TOOL_EVENT& aEvent );
     void deleteTraces( ITEM* aStartItem, bool aWholeTrack );
 
+    /**
+     * When the KICAD_PNS_RECORD environment variable is set to a file name (without
+     * extension), saves the board as <name>.kicad_pcb and starts recording the router
+     * calls.  saveRecording() writes them to <name>.events, for the pns_replay benchmark.
+     */
+    void startRecording();
+    void saveRecording();
+
     MSG_PANEL_ITEMS m_panelItems;
 
     ROUTING_SETTINGS m_savedSettings;     ///< Stores routing settings between router invocations
@@ -19,6 +19,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <core/optional.h>
 
 #include <geometry/shape_line_chain.h>
@@ -52,12 +54,14 @@ NODE::OPT_OBSTACLE WALKAROUND::nearestObstacle( const LINE& aPath )
 
 
 WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
-                                                              bool aWindingDirection )
+                                                      bool aWindingDirection, int aIteration )
 {
+    // Each winding direction has its own state: the two walks may run in parallel.
     OPT<OBSTACLE>& current_obs =
         aWindingDirection ? m_currentObstacle[0] : m_currentObstacle[1];
 
     bool& prev_recursive = aWindingDirection ? m_recursiveCollision[0] : m_recursiveCollision[1];
+    int& blockage_count = aWindingDirection ? m_recursiveBlockageCount[0] : m_recursiveBlockageCount[1];
 
     if( !current_obs )
         return DONE;
@@ -68,13 +72,14 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 
     if( ( current_obs->m_hull ).PointInside( last ) || ( current_obs->m_hull ).PointOnEdge( last ) )
     {
-        m_recursiveBlockageCount++;
+        blockage_count++;
 
-        if( m_recursiveBlockageCount < 3 )
+        if( blockage_count < 3 )
             aPath.Line().Append( current_obs->m_hull.NearestPoint( last ) );
         else
         {
             aPath = aPath.ClipToNearestObstacle( m_world );
+            current_obs = NODE::OPT_OBSTACLE();
             return DONE;
         }
     }
@@ -88,12 +93,16 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
         return STUCK;
 
 #ifdef DEBUG
-    m_logger.NewGroup( aWindingDirection ? "walk-cw" : "walk-ccw", m_iteration );
-    m_logger.Log( &path_walk[0], 0, "path-walk" );
-    m_logger.Log( &path_pre[0], 1, "path-pre" );
-    m_logger.Log( &path_post[0], 4, "path-post" );
-    m_logger.Log( &current_obs->m_hull, 2, "hull" );
-    m_logger.Log( current_obs->m_item, 3, "item" );
+    {
+        std::lock_guard<std::mutex> lock( m_loggerLock );
+
+        m_logger.NewGroup( aWindingDirection ? "walk-cw" : "walk-ccw", aIteration );
+        m_logger.Log( &path_walk[0], 0, "path-walk" );
+        m_logger.Log( &path_pre[0], 1, "path-pre" );
+        m_logger.Log( &path_post[0], 4, "path-post" );
+        m_logger.Log( &current_obs->m_hull, 2, "hull" );
+        m_logger.Log( current_obs->m_item, 3, "item" );
+    }
 #endif
 
     int len_pre = path_walk[0].Length();
@@ -144,10 +153,48 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 }
 
 
+bool WALKAROUND::stepWalk( WALK& aWalk, bool aWindingDirection,
+                           std::atomic<int>& aStopIteration )
+{
+    if( aWalk.m_status != IN_PROGRESS || aWalk.m_steps >= m_iterationLimit
+            || aWalk.m_steps > aStopIteration )
+        return false;
+
+    aWalk.m_status = singleStep( aWalk.m_path, aWindingDirection, aWalk.m_steps );
+
+    // Unless the longer path is requested, Route() takes the first walk that is done,
+    // so there is no point in stepping the other one past this iteration.
+    if( aWalk.m_status == DONE && !m_forceLongerPath )
+    {
+        int stop = aStopIteration;
+
+        while( aWalk.m_steps < stop && !aStopIteration.compare_exchange_weak( stop, aWalk.m_steps ) )
+            ;
+    }
+
+    aWalk.m_steps++;
+
+    return aWalk.m_status == IN_PROGRESS;
+}
+
+
+WALKAROUND::WALKAROUND_STATUS WALKAROUND::walkStatus( const WALK& aWalk, int aIteration ) const
+{
+    // DONE and STUCK are final: once reached, the walk stays in that state.
+    if( aWalk.m_status != IN_PROGRESS && aIteration >= aWalk.m_steps - 1 )
+        return aWalk.m_status;
+
+    return IN_PROGRESS;
+}
+
+
 WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
         LINE& aWalkPath, bool aOptimize )
 {
-    LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
+    // Number of iterations both walks are stepped for in the calling thread, before
+    // the walk is considered hard enough to be worth a second thread.
+    const int serialIterations = 2;
+
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
     SHAPE_LINE_CHAIN best_path;
 
@@ -163,8 +210,12 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
 
     start( aInitialPath );
 
+    TIME_LIMIT timeLimit = Settings().WalkaroundTimeLimit();
+    timeLimit.Restart();
+
     m_currentObstacle[0] = m_currentObstacle[1] = nearestObstacle( aInitialPath );
-    m_recursiveBlockageCount = 0;
+    m_recursiveBlockageCount[0] = m_recursiveBlockageCount[1] = 0;
+    m_recursiveCollision[0] = m_recursiveCollision[1] = false;
 
     aWalkPath = aInitialPath;
 
@@ -177,13 +228,66 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
         m_forceSingleDirection = false;
     }
 
-    while( m_iteration < m_iterationLimit )
+    // The clockwise and counter-clockwise walks only read the world, so they are
+    // independent. Step them side by side, and if both are still going after a few
+    // iterations, finish the counter-clockwise one on the router's worker thread, which
+    // is kept between calls so Route() does not pay for creating a thread.
+    WALK walk_cw = { aInitialPath, s_cw, 0 };
+    WALK walk_ccw = { aInitialPath, s_ccw, 0 };
+    std::atomic<int> stopIteration( m_iterationLimit );
+    bool cw_running = true, ccw_running = true;
+
+    for( int i = 0; i < serialIterations && ( cw_running || ccw_running ); i++ )
+    {
+        cw_running = stepWalk( walk_cw, true, stopIteration );
+        ccw_running = stepWalk( walk_ccw, false, stopIteration );
+
+        if( timeLimit.Expired() )
+            cw_running = ccw_running = false;
+    }
+
+    auto finishCcw = [&]()
+    {
+        while( stepWalk( walk_ccw, false, stopIteration ) && !timeLimit.Expired() )
+            ;
+    };
+
+    if( cw_running && ccw_running && Router() && Router()->Worker().Start( finishCcw ) )
+    {
+        while( stepWalk( walk_cw, true, stopIteration ) && !timeLimit.Expired() )
+            ;
+
+        Router()->Worker().Wait();
+    }
+    else
     {
-        if( s_cw != STUCK )
-            s_cw = singleStep( path_cw, true );
+        while( cw_running || ccw_running )
+        {
+            cw_running = stepWalk( walk_cw, true, stopIteration );
+            ccw_running = stepWalk( walk_ccw, false, stopIteration );
+
+            if( timeLimit.Expired() )
+                break;
+        }
+    }
+
+    // Pick the result the same way as when stepping both walks in lockstep. A walk
+    // stopped by the time limit is only known up to the iterations it has made.
+    int iterationLimit = m_iterationLimit;
 
-        if( s_ccw != STUCK )
-            s_ccw = singleStep( path_ccw, false );
+    if( walk_cw.m_status == IN_PROGRESS )
+        iterationLimit = std::min( iterationLimit, walk_cw.m_steps );
+
+    if( walk_ccw.m_status == IN_PROGRESS )
+        iterationLimit = std::min( iterationLimit, walk_ccw.m_steps );
+
+    const LINE& path_cw = walk_cw.m_path;
+    const LINE& path_ccw = walk_ccw.m_path;
+
+    for( m_iteration = 0; m_iteration < iterationLimit; m_iteration++ )
+    {
+        s_cw = walkStatus( walk_cw, m_iteration );
+        s_ccw = walkStatus( walk_ccw, m_iteration );
 
         if( ( s_cw == DONE && s_ccw == DONE ) || ( s_cw == STUCK && s_ccw == STUCK ) )
         {
@@ -207,11 +311,9 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
             aWalkPath = path_ccw;
             break;
         }
-
-        m_iteration++;
     }
 
-    if( m_iteration == m_iterationLimit )
+    if( m_iteration == iterationLimit )
     {
         int len_cw  = path_cw.CLine().Length();
         int len_ccw = path_ccw.CLine().Length();
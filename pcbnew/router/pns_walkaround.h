@@ -22,6 +22,8 @@
 #ifndef __PNS_WALKAROUND_H
 #define __PNS_WALKAROUND_H
 
+#include <atomic>
+#include <mutex>
 #include <set>
 
 #include "pns_line.h"
@@ -49,7 +51,7 @@ public:
         m_itemMask = ITEM::ANY_T;
 
         // Initialize other members, to avoid uninitialized variables.
-        m_recursiveBlockageCount = 0;
+        m_recursiveBlockageCount[0] = m_recursiveBlockageCount[1] = 0;
         m_recursiveCollision[0] = m_recursiveCollision[1] = false;
         m_iteration = 0;
         m_forceCw = false;
@@ -127,14 +129,30 @@ public:
     }
 
 private:
+    ///> state of the walk in one winding direction
+    struct WALK
+    {
+        LINE m_path;
+        WALKAROUND_STATUS m_status;
+
+        ///> number of iterations the walk has been stepped for
+        int m_steps;
+    };
+
     void start( const LINE& aInitialPath );
 
-    WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection );
+    WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection, int aIteration );
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
 
+    ///> advances aWalk by one iteration. Returns false if the walk must not be stepped anymore.
+    bool stepWalk( WALK& aWalk, bool aWindingDirection, std::atomic<int>& aStopIteration );
+
+    ///> status of aWalk as the (serial) Route() loop saw it after iteration aIteration
+    WALKAROUND_STATUS walkStatus( const WALK& aWalk, int aIteration ) const;
+
     NODE* m_world;
 
-    int m_recursiveBlockageCount;
+    int m_recursiveBlockageCount[2];
     int m_iteration;
     int m_iterationLimit;
     int m_itemMask;
@@ -146,6 +164,7 @@ private:
     NODE::OPT_OBSTACLE m_currentObstacle[2];
     bool m_recursiveCollision[2];
     LOGGER m_logger;
+    std::mutex m_loggerLock;
     std::set<ITEM*> m_restrictedSet;
 };
 
@@ -0,0 +1,100 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pns_worker.h"
+
+namespace PNS {
+
+WORKER::WORKER() :
+    m_busy( false ),
+    m_quit( false )
+{
+}
+
+
+WORKER::~WORKER()
+{
+    if( !m_thread.joinable() )
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+        m_quit = true;
+    }
+
+    m_changed.notify_all();
+    m_thread.join();
+}
+
+
+bool WORKER::Start( const std::function<void()>& aJob )
+{
+    if( std::thread::hardware_concurrency() < 2 )
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        if( m_busy )
+            return false;
+
+        m_job = aJob;
+        m_busy = true;
+    }
+
+    if( !m_thread.joinable() )
+        m_thread = std::thread( &WORKER::run, this );
+
+    m_changed.notify_all();
+    return true;
+}
+
+
+void WORKER::Wait()
+{
+    std::unique_lock<std::mutex> lock( m_lock );
+
+    m_changed.wait( lock, [this]() { return !m_busy; } );
+}
+
+
+void WORKER::run()
+{
+    std::unique_lock<std::mutex> lock( m_lock );
+
+    while( true )
+    {
+        m_changed.wait( lock, [this]() { return m_quit || ( m_busy && m_job ); } );
+
+        if( m_quit )
+            return;
+
+        std::function<void()> job;
+        std::swap( job, m_job );
+
+        lock.unlock();
+        job();
+        lock.lock();
+
+        m_busy = false;
+        m_changed.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_WORKER_H
+#define __PNS_WORKER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace PNS {
+
+/**
+ * Class WORKER
+ *
+ * A single background thread, kept for the lifetime of its owner (the router), running one
+ * job at a time. The thread is started by the first job, so a router which never needs it
+ * does not create it.
+ */
+class WORKER
+{
+public:
+    WORKER();
+    ~WORKER();
+
+    /**
+     * Function Start()
+     * Starts running aJob on the worker thread.
+     * @return false if the worker is still busy with another job (or no second thread is
+     * available): the caller must then run aJob itself.
+     */
+    bool Start( const std::function<void()>& aJob );
+
+    /**
+     * Function Wait()
+     * Blocks until the job passed to the last successful Start() has returned.
+     */
+    void Wait();
+
+private:
+    void run();
+
+    std::thread             m_thread;
+    std::mutex              m_lock;
+    std::condition_variable m_changed;
+    std::function<void()>   m_job;
+    bool                    m_busy;
+    bool                    m_quit;
+};
+
+}
+
+#endif
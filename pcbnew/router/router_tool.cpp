@@ -922,6 +922,7 @@ int ROUTER_TOOL::mainLoop( PNS::ROUTER_MODE aMode )
     Activate();
 
     m_router->SetMode( aMode );
+    startRecording();
 
     VIEW_CONTROLS* ctls = getViewControls();
     ctls->ShowCursor( true );
@@ -982,6 +983,7 @@ int ROUTER_TOOL::mainLoop( PNS::ROUTER_MODE aMode )
 
     frame->SetNoToolSelected();
     SetContextMenu( nullptr );
+    saveRecording();
 
     // Store routing settings till the next invocation
     m_savedSettings = m_router->Settings();
@@ -1164,10 +1166,16 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
 
     int dragMode = aEvent.Parameter<int64_t> ();
 
+    // The recording replays StartDragging(), so it starts before it
+    startRecording();
+
     bool dragStarted = m_router->StartDragging( p0, m_startItem, dragMode );
 
     if( !dragStarted )
+    {
+        m_router->StopRecording();
         return 0;
+    }
 
     controls()->ShowCursor( true );
     controls()->ForceCursorPosition( false );
@@ -1196,6 +1204,8 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     if( m_router->RoutingInProgress() )
         m_router->StopRouting();
 
+    saveRecording();
+
     controls()->SetAutoPan( false );
     controls()->ForceCursorPosition( false );
     frame()->UndoRedoBlock( false );
@@ -0,0 +1,12 @@
+// the DRC dialog and the legacy canvas online checks are not usable from scripts
+%ignore DRC::ShowDRCDialog;
+%ignore DRC::DestroyDRCDialog;
+%ignore DRC::DrcOnCreatingTrack;
+%ignore DRC::DrcOnCreatingZone;
+%ignore DRC_ITEM_LIST;
+
+%include drc.h
+%{
+#include <drc.h>
+%}
+
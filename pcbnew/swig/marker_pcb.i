@@ -1,6 +1,9 @@
-
+%include drc_item.h
+%include marker_base.h
 %include class_marker_pcb.h
 %{
+#include <drc_item.h>
+#include <marker_base.h>
 #include <class_marker_pcb.h>
 %}
 
@@ -122,6 +122,7 @@ HANDLE_EXCEPTIONS(LoadBoard)
 
 %include board.i
 %include footprint.i
+%include drc.i
 %include plugins.i
 %include units.i
 
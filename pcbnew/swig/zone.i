@@ -7,3 +7,10 @@
 #include <zones.h>
 %}
 
+// the fills started from scripts report no progress
+%ignore ZONE_FILLER::SetProgressReporter;
+
+%include zone_filler.h
+%{
+#include <zone_filler.h>
+%}
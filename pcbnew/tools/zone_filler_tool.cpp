@@ -119,8 +119,10 @@ int ZONE_FILLER_TOOL::ZoneFillAll( const TOOL_EVENT& aEvent )
     ZONE_FILLER filler( board(), &commit );
     filler.SetProgressReporter( progressReporter.get() );
 
+    // An explicit Fill All refills every zone entirely, whatever the changes since
+    // the last fill: some (e.g. a global clearance change) have no known area
     if( filler.Fill( toFill ) )
-        frame()->m_ZoneFillsDirty = false;
+        frame()->ClearZoneFillsDirty();
 
     return 0;
 }
@@ -368,7 +368,7 @@ bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPo
     if( !citem->Valid() )
         return false;
 
-    auto anchors = citem->Anchors();
+    const auto& anchors = citem->Anchors();
 
     for( const auto& anchor : anchors )
     {
@@ -24,6 +24,7 @@
  */
 
 #include <cstdint>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 
@@ -67,7 +68,7 @@ static const bool s_DumpZonesWhenFilling = false;
 
 ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
     m_board( aBoard ), m_commit( aCommit ), m_progressReporter( nullptr ),
-    m_next( 0 ), m_count_done( 0 )
+    m_hasRefillArea( false ), m_next( 0 ), m_count_done( 0 )
 {
 }
 
@@ -82,6 +83,14 @@ void ZONE_FILLER::SetProgressReporter( WX_PROGRESS_REPORTER* aReporter )
     m_progressReporter = aReporter;
 }
 
+
+void ZONE_FILLER::SetRefillArea( const EDA_RECT& aArea )
+{
+    m_refillArea = aArea;
+    m_refillArea.Normalize();
+    m_hasRefillArea = true;
+}
+
 bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 {
     int parallelThreadCount = std::max( ( int )std::thread::hardware_concurrency(), 2 );
@@ -98,9 +107,22 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
         if( zone->GetIsKeepout() )
             continue;
 
+        // Zones too far from the changes keep their current fill, when it is still
+        // valid there (unfilled zones, or zones loaded from a file, need a complete fill)
+        if( canKeepFill( zone ) && !zone->GetBoundingBox().Intersects( refillWindow( zone ) ) )
+            continue;
+
         toFill.emplace_back( CN_ZONE_ISOLATED_ISLAND_LIST(zone) );
     }
 
+    // Start with the biggest zones, so a large plane picked up last does not keep
+    // a single thread busy while the others are idle
+    std::stable_sort( toFill.begin(), toFill.end(),
+            []( const CN_ZONE_ISOLATED_ISLAND_LIST& a, const CN_ZONE_ISOLATED_ISLAND_LIST& b )
+            {
+                return a.m_zone->GetBoundingBox().GetArea() > b.m_zone->GetBoundingBox().GetArea();
+            } );
+
     for( unsigned i = 0; i < toFill.size(); i++ )
     {
         if( m_commit )
@@ -115,20 +137,31 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
         m_progressReporter->SetMaxProgress( toFill.size() );
     }
 
+    std::vector<ZONE_CONTAINER*> zones;
+
+    for( auto& zone : toFill )
+        zones.push_back( zone.m_zone );
+
+    buildObstacleCache( zones, parallelThreadCount );
+
     m_next = 0;
     m_count_done = 0;
     std::vector<std::thread> fillWorkers;
 
     for( ssize_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        fillWorkers.push_back( std::thread( [ this, toFill ]()
+        fillWorkers.push_back( std::thread( [ this, &toFill ]()
         {
             size_t i = m_next.fetch_add( 1 );
             while( i < toFill.size() )
             {
                 SHAPE_POLY_SET rawPolys, finalPolys;
                 ZONE_CONTAINER* zone = toFill[i].m_zone;
-                fillSingleZone( zone, rawPolys, finalPolys );
+
+                if( canRefillArea( zone ) )
+                    refillZoneArea( zone, rawPolys, finalPolys );
+                else
+                    fillSingleZone( zone, rawPolys, finalPolys );
 
                 zone->SetRawPolysList( rawPolys );
                 zone->SetFilledPolysList( finalPolys );
@@ -154,6 +187,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
     for( size_t ii = 0; ii < fillWorkers.size(); ++ii )
         fillWorkers[ ii ].join();
 
+    m_obstacles.clear();
+
     // Now remove insulated copper islands
     if( m_progressReporter )
     {
@@ -224,7 +259,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 
     for( ssize_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        triangulationWorkers.push_back( std::thread( [ this, toFill ]()
+        triangulationWorkers.push_back( std::thread( [ this, &toFill ]()
         {
             size_t i = m_next.fetch_add( 1 );
             while( i < toFill.size() )
@@ -232,7 +267,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
                 if( m_progressReporter )
                     m_progressReporter->AdvanceProgress();
 
-                toFill[i].m_zone->CacheTriangulation();
+                // Already on a worker thread: do not spawn more threads per zone
+                toFill[i].m_zone->CacheTriangulation( false );
 
                 m_count_done.fetch_add( 1 );
                 i = m_next.fetch_add( 1 );
@@ -317,6 +353,213 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 }
 
 
+bool ZONE_FILLER::ZONE_OBSTACLE_KEY::operator<( const ZONE_OBSTACLE_KEY& aOther ) const
+{
+    if( m_layer != aOther.m_layer )
+        return m_layer < aOther.m_layer;
+
+    if( m_segsPerCircle != aOther.m_segsPerCircle )
+        return m_segsPerCircle < aOther.m_segsPerCircle;
+
+    if( m_zoneClearance != aOther.m_zoneClearance )
+        return m_zoneClearance < aOther.m_zoneClearance;
+
+    return m_halfThickness < aOther.m_halfThickness;
+}
+
+
+ZONE_FILLER::ZONE_OBSTACLE_KEY ZONE_FILLER::obstacleKey( const ZONE_CONTAINER* aZone ) const
+{
+    ZONE_OBSTACLE_KEY key;
+
+    key.m_layer = aZone->GetLayer();
+    key.m_segsPerCircle = aZone->GetArcSegmentCount() > SEGMENT_COUNT_CROSSOVER ?
+                          ARC_APPROX_SEGMENTS_COUNT_HIGHT_DEF : ARC_APPROX_SEGMENTS_COUNT_LOW_DEF;
+    key.m_halfThickness = aZone->GetMinThickness() / 2;
+    key.m_zoneClearance = aZone->GetClearance() + key.m_halfThickness;
+
+    return key;
+}
+
+
+void ZONE_FILLER::buildObstacleCache( const std::vector<ZONE_CONTAINER*>& aZones,
+        int aThreadCount )
+{
+    m_obstacles.clear();
+
+    // Area covered by the zones using each key, to skip items no zone can reach
+    std::map<ZONE_OBSTACLE_KEY, EDA_RECT> areas;
+    int biggest_clearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+
+    for( auto zone : aZones )
+    {
+        ZONE_OBSTACLE_KEY key = obstacleKey( zone );
+        EDA_RECT bbox;
+        int margin = std::max( biggest_clearance, key.m_zoneClearance );
+
+        if( canRefillArea( zone ) )
+        {
+            // Only the obstacles reaching the area computed by refillZoneArea() are needed
+            bbox = refillWindow( zone );
+            bbox.Inflate( 2 * ( margin + zone->GetMinThickness() ) );
+        }
+        else
+        {
+            bbox = zone->GetBoundingBox();
+            bbox.Inflate( margin );
+        }
+
+        auto it = areas.find( key );
+
+        if( it == areas.end() )
+            areas[key] = bbox;
+        else
+            it->second.Merge( bbox );
+    }
+
+    for( auto& area : areas )
+        m_obstacles[area.first] = ZONE_OBSTACLES();
+
+    struct JOB
+    {
+        const ZONE_OBSTACLE_KEY* key;
+        BOARD_CONNECTED_ITEM*    item;
+        bool                     valid;
+        ZONE_OBSTACLE            obstacle;
+    };
+
+    std::vector<JOB> jobs;
+
+    for( auto& area : areas )
+    {
+        const ZONE_OBSTACLE_KEY& key = area.first;
+
+        for( auto module : m_board->Modules() )
+        {
+            for( auto pad : module->Pads() )
+            {
+                if( !pad->IsOnLayer( key.m_layer )
+                        && pad->GetDrillSize().x == 0 && pad->GetDrillSize().y == 0 )
+                    continue;
+
+                jobs.push_back( { &key, pad, false, ZONE_OBSTACLE() } );
+            }
+        }
+
+        for( auto track : m_board->Tracks() )
+        {
+            if( !track->IsOnLayer( key.m_layer ) )
+                continue;
+
+            if( !track->GetBoundingBox().Intersects( area.second ) )
+                continue;
+
+            jobs.push_back( { &key, track, false, ZONE_OBSTACLE() } );
+        }
+    }
+
+    std::atomic_size_t next( 0 );
+    std::vector<std::thread> workers;
+
+    for( int ii = 0; ii < aThreadCount; ++ii )
+    {
+        workers.push_back( std::thread( [ this, &jobs, &next, &areas ]()
+        {
+            // Pads not on the zone layer but having a hole use a dummy pad having
+            // the size and shape of the hole (see buildZoneFeatureHoleList())
+            MODULE  dummymodule( m_board );
+            D_PAD   dummypad( &dummymodule );
+
+            for( size_t i = next.fetch_add( 1 ); i < jobs.size(); i = next.fetch_add( 1 ) )
+            {
+                JOB& job = jobs[i];
+                const ZONE_OBSTACLE_KEY& key = *job.key;
+                double correctionFactor = GetCircletoPolyCorrectionFactor( key.m_segsPerCircle );
+                ZONE_OBSTACLE& obstacle = job.obstacle;
+
+                if( job.item->Type() != PCB_PAD_T )
+                {
+                    TRACK* track = static_cast<TRACK*>( job.item );
+                    int clearance = std::max( key.m_zoneClearance,
+                                              track->GetClearance() + key.m_halfThickness );
+
+                    obstacle.m_netCode = track->GetNetCode();
+                    obstacle.m_bbox = track->GetBoundingBox();
+                    track->TransformShapeWithClearanceToPolygon( obstacle.m_poly, clearance,
+                            key.m_segsPerCircle, correctionFactor );
+                    job.valid = true;
+                    continue;
+                }
+
+                D_PAD* pad = static_cast<D_PAD*>( job.item );
+
+                if( !pad->IsOnLayer( key.m_layer ) )
+                {
+                    dummypad.SetSize( pad->GetDrillSize() );
+                    dummypad.SetOrientation( pad->GetOrientation() );
+                    dummypad.SetShape( pad->GetDrillShape() == PAD_DRILL_SHAPE_OBLONG ?
+                            PAD_SHAPE_OVAL : PAD_SHAPE_CIRCLE );
+                    dummypad.SetPosition( pad->GetPosition() );
+
+                    pad = &dummypad;
+                }
+
+                int item_clearance = pad->GetClearance() + key.m_halfThickness;
+
+                obstacle.m_netCode = pad->GetNetCode();
+                obstacle.m_bbox = pad->GetBoundingBox();
+                obstacle.m_bbox.Inflate( item_clearance );
+
+                if( !obstacle.m_bbox.Intersects( areas.at( key ) ) )
+                    continue;
+
+                int clearance = std::max( key.m_zoneClearance, item_clearance );
+
+                // PAD_SHAPE_CUSTOM can have a specific keepout, to avoid to break the shape
+                if( pad->GetShape() == PAD_SHAPE_CUSTOM
+                    && pad->GetCustomShapeInZoneOpt() == CUST_PAD_SHAPE_IN_ZONE_CONVEXHULL )
+                {
+                    SHAPE_POLY_SET outline( pad->GetCustomShapeAsPolygon() );
+                    outline.Inflate( KiROUND( clearance * correctionFactor ),
+                                     key.m_segsPerCircle );
+                    pad->CustomShapeAsPolygonToBoardPosition( &outline,
+                            pad->GetPosition(), pad->GetOrientation() );
+
+                    std::vector<wxPoint> convex_hull;
+                    BuildConvexHull( convex_hull, outline );
+
+                    obstacle.m_poly.NewOutline();
+
+                    for( const wxPoint& pt : convex_hull )
+                        obstacle.m_poly.Append( pt );
+                }
+                else
+                    pad->TransformShapeWithClearanceToPolygon( obstacle.m_poly, clearance,
+                            key.m_segsPerCircle, correctionFactor );
+
+                job.valid = true;
+            }
+        } ) );
+    }
+
+    for( auto& worker : workers )
+        worker.join();
+
+    for( auto& job : jobs )
+    {
+        if( !job.valid )
+            continue;
+
+        ZONE_OBSTACLES& obstacles = m_obstacles[*job.key];
+
+        if( job.item->Type() == PCB_PAD_T )
+            obstacles.m_pads.push_back( std::move( job.obstacle ) );
+        else
+            obstacles.m_tracks.push_back( std::move( job.obstacle ) );
+    }
+}
+
+
 void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
         SHAPE_POLY_SET& aFeatures ) const
 {
@@ -362,94 +605,32 @@ void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
     zone_boundingbox.Inflate( biggest_clearance );
 
     /*
-     * First : Add pads. Note: pads having the same net as zone are left in zone.
+     * First : Add pads, tracks and vias of other nets. Their clearance polygons
+     * were built by buildObstacleCache() and are shared by all the zones having the
+     * same layer and clearance settings.
+     * Note: pads having the same net as zone are left in zone.
      * Thermal shapes will be created later if necessary
      */
+    const ZONE_OBSTACLES& obstacles = m_obstacles.at( obstacleKey( aZone ) );
 
-    /* Use a dummy pad to calculate hole clearance when a pad is not on all copper layers
-     * and this pad has a hole
-     * This dummy pad has the size and shape of the hole
-     * Therefore, this dummy pad is a circle or an oval.
-     * A pad must have a parent because some functions expect a non null parent
-     * to find the parent board, and some other data
-     */
-    MODULE  dummymodule( m_board );   // Creates a dummy parent
-    D_PAD   dummypad( &dummymodule );
-
-    for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    for( const ZONE_OBSTACLE& obstacle : obstacles.m_pads )
     {
-        D_PAD* nextpad;
-
-        for( D_PAD* pad = module->PadsList(); pad != NULL; pad = nextpad )
-        {
-            nextpad = pad->Next();      // pad pointer can be modified by next code, so
-                                        // calculate the next pad here
-
-            if( !pad->IsOnLayer( aZone->GetLayer() ) )
-            {
-                /* Test for pads that are on top or bottom only and have a hole.
-                 * There are curious pads but they can be used for some components that are
-                 * inside the board (in fact inside the hole. Some photo diodes and Leds are
-                 * like this)
-                 */
-                if( pad->GetDrillSize().x == 0 && pad->GetDrillSize().y == 0 )
-                    continue;
-
-                // Use a dummy pad to calculate a hole shape that have the same dimension as
-                // the pad hole
-                dummypad.SetSize( pad->GetDrillSize() );
-                dummypad.SetOrientation( pad->GetOrientation() );
-                dummypad.SetShape( pad->GetDrillShape() == PAD_DRILL_SHAPE_OBLONG ?
-                        PAD_SHAPE_OVAL : PAD_SHAPE_CIRCLE );
-                dummypad.SetPosition( pad->GetPosition() );
-
-                pad = &dummypad;
-            }
-
-            // Note: netcode <=0 means not connected item
-            if( ( pad->GetNetCode() != aZone->GetNetCode() ) || ( pad->GetNetCode() <= 0 ) )
-            {
-                int item_clearance = pad->GetClearance() + outline_half_thickness;
-                item_boundingbox = pad->GetBoundingBox();
-                item_boundingbox.Inflate( item_clearance );
-
-                if( item_boundingbox.Intersects( zone_boundingbox ) )
-                {
-                    int clearance = std::max( zone_clearance, item_clearance );
-
-                    // PAD_SHAPE_CUSTOM can have a specific keepout, to avoid to break the shape
-                    if( pad->GetShape() == PAD_SHAPE_CUSTOM
-                        && pad->GetCustomShapeInZoneOpt() == CUST_PAD_SHAPE_IN_ZONE_CONVEXHULL )
-                    {
-                        // the pad shape in zone can be its convex hull or
-                        // the shape itself
-                        SHAPE_POLY_SET outline( pad->GetCustomShapeAsPolygon() );
-                        outline.Inflate( KiROUND( clearance * correctionFactor ), segsPerCircle );
-                        pad->CustomShapeAsPolygonToBoardPosition( &outline,
-                                pad->GetPosition(), pad->GetOrientation() );
-
-                        if( pad->GetCustomShapeInZoneOpt() == CUST_PAD_SHAPE_IN_ZONE_CONVEXHULL )
-                        {
-                            std::vector<wxPoint> convex_hull;
-                            BuildConvexHull( convex_hull, outline );
-
-                            aFeatures.NewOutline();
+        // Note: netcode <=0 means not connected item
+        if( obstacle.m_netCode == aZone->GetNetCode() && obstacle.m_netCode > 0 )
+            continue;
 
-                            for( unsigned ii = 0; ii < convex_hull.size(); ++ii )
-                                aFeatures.Append( convex_hull[ii] );
-                        }
-                        else
-                            aFeatures.Append( outline );
-                    }
-                    else
-                        pad->TransformShapeWithClearanceToPolygon( aFeatures,
-                                clearance,
-                                segsPerCircle,
-                                correctionFactor );
-                }
+        if( obstacle.m_bbox.Intersects( zone_boundingbox ) )
+            aFeatures.Append( obstacle.m_poly );
+    }
 
+    for( auto module : m_board->Modules() )
+    {
+        for( auto pad : module->Pads() )
+        {
+            // Pads of other nets and holes of pads not on this layer are obstacles
+            if( !pad->IsOnLayer( aZone->GetLayer() )
+                || pad->GetNetCode() != aZone->GetNetCode() || pad->GetNetCode() <= 0 )
                 continue;
-            }
 
             // Pads are removed from zone if the setup is PAD_ZONE_CONN_NONE
             // or if they have a custom shape and not PAD_ZONE_CONN_FULL,
@@ -497,25 +678,13 @@ void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
     /* Add holes (i.e. tracks and vias areas as polygons outlines)
      * in cornerBufferPolysToSubstract
      */
-    for( auto track : m_board->Tracks() )
+    for( const ZONE_OBSTACLE& obstacle : obstacles.m_tracks )
     {
-        if( !track->IsOnLayer( aZone->GetLayer() ) )
+        if( obstacle.m_netCode == aZone->GetNetCode() && ( aZone->GetNetCode() != 0 ) )
             continue;
 
-        if( track->GetNetCode() == aZone->GetNetCode()  && ( aZone->GetNetCode() != 0) )
-            continue;
-
-        int item_clearance = track->GetClearance() + outline_half_thickness;
-        item_boundingbox = track->GetBoundingBox();
-
-        if( item_boundingbox.Intersects( zone_boundingbox ) )
-        {
-            int clearance = std::max( zone_clearance, item_clearance );
-            track->TransformShapeWithClearanceToPolygon( aFeatures,
-                    clearance,
-                    segsPerCircle,
-                    correctionFactor );
-        }
+        if( obstacle.m_bbox.Intersects( zone_boundingbox ) )
+            aFeatures.Append( obstacle.m_poly );
     }
 
     /* Add module edge items that are on copper layers
@@ -829,6 +998,138 @@ bool ZONE_FILLER::fillSingleZone( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& a
     return true;
 }
 
+/**
+ * @return the area covered by the thermal relief of \a aPad in \a aZone, stubs included.
+ */
+static EDA_RECT thermalReliefArea( const ZONE_CONTAINER* aZone, D_PAD* aPad )
+{
+    EDA_RECT area = aPad->GetBoundingBox();
+
+    area.Inflate( aZone->GetThermalReliefGap( aPad ) + aZone->GetThermalReliefCopperBridge( aPad )
+                  + aZone->GetMinThickness() );
+
+    return area;
+}
+
+
+bool ZONE_FILLER::canKeepFill( const ZONE_CONTAINER* aZone ) const
+{
+    // The raw polygons are not saved in board files, so zones loaded from a file
+    // have to be filled entirely once
+    return m_hasRefillArea && aZone->IsFilled() && aZone->IsOnCopperLayer()
+           && !aZone->GetRawPolysList().IsEmpty();
+}
+
+
+bool ZONE_FILLER::canRefillArea( const ZONE_CONTAINER* aZone ) const
+{
+    if( !canKeepFill( aZone ) )
+        return false;
+
+    // The stubs of a thermal relief are kept or removed depending on the fill all around
+    // the pad: when the window edge crosses a thermal relief, the zone is filled entirely
+    EDA_RECT window = refillWindow( aZone );
+
+    for( auto module : m_board->Modules() )
+    {
+        for( auto pad : module->Pads() )
+        {
+            if( pad->GetNetCode() != aZone->GetNetCode() || !pad->IsOnLayer( aZone->GetLayer() ) )
+                continue;
+
+            EDA_RECT thermal = thermalReliefArea( aZone, pad );
+
+            if( thermal.Intersects( window ) && !window.Contains( thermal ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+EDA_RECT ZONE_FILLER::refillWindow( const ZONE_CONTAINER* aZone ) const
+{
+    int biggest_clearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+    int margin = std::max( biggest_clearance, aZone->GetClearance() ) + aZone->GetMinThickness();
+
+    EDA_RECT area = m_refillArea;
+    area.Inflate( margin );
+
+    EDA_RECT window = area;
+
+    // A change near a pad connected to the zone can add or remove its thermal stubs,
+    // so the whole thermal relief of these pads must be rebuilt
+    for( auto module : m_board->Modules() )
+    {
+        for( auto pad : module->Pads() )
+        {
+            if( pad->GetNetCode() != aZone->GetNetCode() || !pad->IsOnLayer( aZone->GetLayer() ) )
+                continue;
+
+            EDA_RECT padArea = thermalReliefArea( aZone, pad );
+
+            if( padArea.Intersects( area ) )
+                window.Merge( padArea );
+        }
+    }
+
+    return window;
+}
+
+
+static SHAPE_POLY_SET rectToPolySet( const EDA_RECT& aRect )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( aRect.GetLeft(), aRect.GetTop() );
+    poly.Append( aRect.GetRight(), aRect.GetTop() );
+    poly.Append( aRect.GetRight(), aRect.GetBottom() );
+    poly.Append( aRect.GetLeft(), aRect.GetBottom() );
+
+    return poly;
+}
+
+
+bool ZONE_FILLER::refillZoneArea( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aRawPolys,
+                                  SHAPE_POLY_SET& aFinalPolys ) const
+{
+    SHAPE_POLY_SET smoothedPoly;
+
+    if( !aZone->BuildSmoothedPoly( smoothedPoly ) )
+        return false;
+
+    // The fill is computed in a window slightly larger than the area to replace:
+    // near the window edges the fill is not valid, as the outline is clipped there.
+    int biggest_clearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+    EDA_RECT window = refillWindow( aZone );
+    EDA_RECT computed = window;
+    computed.Inflate( biggest_clearance + 2 * aZone->GetMinThickness() );
+
+    SHAPE_POLY_SET windowPoly = rectToPolySet( window );
+
+    smoothedPoly.BooleanIntersection( rectToPolySet( computed ), SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET newRaw, newFinal;
+
+    if( smoothedPoly.OutlineCount() )
+    {
+        computeRawFilledAreas( aZone, smoothedPoly, newRaw, newFinal );
+        newRaw.BooleanIntersection( windowPoly, SHAPE_POLY_SET::PM_FAST );
+    }
+
+    aRawPolys = aZone->GetRawPolysList();
+    aRawPolys.BooleanSubtract( windowPoly, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanAdd( newRaw, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    aRawPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    aFinalPolys = aRawPolys;
+
+    return true;
+}
+
+
 bool ZONE_FILLER::fillZoneWithSegments( const ZONE_CONTAINER* aZone,
                                         const SHAPE_POLY_SET& aFilledPolys,
                                         ZONE_SEGMENT_FILL& aFillSegs ) const
@@ -27,6 +27,7 @@
 #define __ZONE_FILLER_H
 
 #include <vector>
+#include <map>
 #include <class_zone.h>
 
 class WX_PROGRESS_REPORTER;
@@ -42,10 +43,85 @@ public:
     ~ZONE_FILLER();
 
     void SetProgressReporter( WX_PROGRESS_REPORTER* aReporter );
+
+    /**
+     * Limit the next Fill() to the area changed since the previous fill.
+     * Zones not reached by the changes are skipped, and zones already filled keep
+     * their filled areas outside of the changed region.  Zones without a previous
+     * fill are filled entirely.
+     * @param aArea is the union of the bounding boxes of the changed items.
+     */
+    void SetRefillArea( const EDA_RECT& aArea );
+
     bool Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck = false );
 
 private:
 
+    /**
+     * A pad, track or via of another net, already converted to a polygon including
+     * its clearance for a given set of zone parameters.
+     */
+    struct ZONE_OBSTACLE
+    {
+        int             m_netCode;
+        EDA_RECT        m_bbox;     // used to reject obstacles outside the zone
+        SHAPE_POLY_SET  m_poly;
+    };
+
+    /**
+     * The zone parameters the obstacle polygons depend on.  Zones sharing the same
+     * key share the same obstacle list.
+     */
+    struct ZONE_OBSTACLE_KEY
+    {
+        PCB_LAYER_ID    m_layer;
+        int             m_segsPerCircle;
+        int             m_zoneClearance;
+        int             m_halfThickness;
+
+        bool operator<( const ZONE_OBSTACLE_KEY& aOther ) const;
+    };
+
+    struct ZONE_OBSTACLES
+    {
+        std::vector<ZONE_OBSTACLE> m_pads;
+        std::vector<ZONE_OBSTACLE> m_tracks;
+    };
+
+    ZONE_OBSTACLE_KEY obstacleKey( const ZONE_CONTAINER* aZone ) const;
+
+    /**
+     * Build the obstacle polygons of pads, tracks and vias once for all the zones to
+     * fill.  The cache is only read by the fill threads.
+     */
+    void buildObstacleCache( const std::vector<ZONE_CONTAINER*>& aZones,
+            int aThreadCount );
+
+    /**
+     * @return true if the fill of the zone is still valid away from the refill area.
+     */
+    bool canKeepFill( const ZONE_CONTAINER* aZone ) const;
+
+    /**
+     * @return true if the zone can be refilled only around the refill area: its fill
+     * can be kept, and the edges of refillWindow() cross no thermal relief of the zone.
+     */
+    bool canRefillArea( const ZONE_CONTAINER* aZone ) const;
+
+    /**
+     * @return the part of aZone whose fill can be changed by the items in the refill
+     * area, including the thermal reliefs of the pads near the changes.
+     */
+    EDA_RECT refillWindow( const ZONE_CONTAINER* aZone ) const;
+
+    /**
+     * Recompute the filled areas of aZone inside refillWindow() only, and merge them
+     * with the previous fill (which is kept outside this window).
+     */
+    bool refillZoneArea( const ZONE_CONTAINER* aZone,
+            SHAPE_POLY_SET& aRawPolys,
+            SHAPE_POLY_SET& aFinalPolys ) const;
+
     void buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
             SHAPE_POLY_SET& aFeatures ) const;
 
@@ -119,6 +195,11 @@ private:
     COMMIT* m_commit;
     WX_PROGRESS_REPORTER* m_progressReporter;
 
+    std::map<ZONE_OBSTACLE_KEY, ZONE_OBSTACLES> m_obstacles;
+
+    EDA_RECT m_refillArea;
+    bool     m_hasRefillArea;
+
     std::atomic_size_t m_next;          // An index into the vector of zones to fill.
                                         // Used by the variuos parallel thread sets during
                                         // fill operations.
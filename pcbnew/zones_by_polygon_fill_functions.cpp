@@ -122,9 +122,14 @@ void PCB_EDIT_FRAME::Check_All_Zones( wxWindow* aActiveWindow )
     ZONE_FILLER filler( GetBoard(), &commit );
     filler.SetProgressReporter( progressReporter.get() );
 
+    EDA_RECT dirtyArea;
+
+    if( GetZoneFillsDirtyArea( dirtyArea ) )
+        filler.SetRefillArea( dirtyArea );
+
     if( filler.Fill( toFill, true ) )
     {
-        m_ZoneFillsDirty = false;
+        ClearZoneFillsDirty();
 
         if( IsGalCanvasActive() && GetGalCanvas() )
             GetGalCanvas()->ForceRefresh();
@@ -0,0 +1,93 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( PolyBandIndex )
+
+/**
+ * Checks that Contains() gives the same answers with the point index as without, for
+ * random points and for points on and next to the vertices.
+ */
+BOOST_AUTO_TEST_CASE( MatchesLinearTest )
+{
+    std::mt19937 rng( 1 );
+    std::uniform_int_distribution<int> position( 0, 20000000 );
+    std::uniform_int_distribution<int> radius( 100000, 900000 );
+
+    SHAPE_POLY_SET disks, holes;
+
+    for( int i = 0; i < 400; i++ )
+    {
+        SHAPE_POLY_SET& set = ( i % 4 ) ? disks : holes;
+        int x = position( rng );
+        int y = position( rng );
+        int r = radius( rng );
+
+        set.NewOutline();
+
+        for( int k = 0; k < 32; k++ )
+            set.Append( x + int( r * cos( k * M_PI / 16 ) ), y + int( r * sin( k * M_PI / 16 ) ) );
+    }
+
+    disks.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET fractured = disks;
+    fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    for( const SHAPE_POLY_SET* set : { &disks, &fractured } )
+    {
+        std::vector<VECTOR2I> points;
+
+        for( int i = 0; i < 20000; i++ )
+            points.push_back( VECTOR2I( position( rng ), position( rng ) ) );
+
+        for( auto it = set->CIterateWithHoles(); it; it++ )
+        {
+            points.push_back( *it );
+            points.push_back( *it + VECTOR2I( 1, 0 ) );
+            points.push_back( *it + VECTOR2I( 0, -1 ) );
+        }
+
+        SHAPE_POLY_SET indexed = *set;
+        indexed.CachePointIndex();
+        BOOST_CHECK( indexed.HasPointIndex() );
+
+        for( const VECTOR2I& p : points )
+        {
+            BOOST_CHECK_EQUAL( indexed.Contains( p ), set->Contains( p ) );
+            BOOST_CHECK_EQUAL( indexed.Contains( p, -1, true ), set->Contains( p, -1, true ) );
+        }
+
+        // Any change drops the index
+        indexed.Move( VECTOR2I( 1, 1 ) );
+        BOOST_CHECK( !indexed.HasPointIndex() );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE( PolySetParallel )
+
+/**
+ * Builds aCount random 16-gons, spread over a square of aSize.  When aRows is not 0, the
+ * centres are snapped to aRows horizontal rows, so that the set has gaps along Y.
+ */
+static SHAPE_POLY_SET randomDisks( int aCount, int aSize, int aRows, unsigned aSeed )
+{
+    std::mt19937 rng( aSeed );
+    std::uniform_int_distribution<int> position( 0, aSize );
+    std::uniform_int_distribution<int> row( 0, std::max( aRows - 1, 0 ) );
+    std::uniform_int_distribution<int> radius( 100000, 600000 );
+    SHAPE_POLY_SET set;
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        int x = position( rng );
+        int y = position( rng );
+        int r = radius( rng );
+
+        if( aRows )
+            y = row( rng ) * ( aSize / aRows ) + y % 800000;
+
+        set.NewOutline();
+
+        for( int k = 0; k < 16; k++ )
+            set.Append( x + int( r * cos( k * M_PI / 8 ) ), y + int( r * sin( k * M_PI / 8 ) ) );
+    }
+
+    return set;
+}
+
+
+/**
+ * Checks that both sets hold the same polygons, in the same order, with the same points.
+ */
+static void checkIdentical( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual )
+{
+    BOOST_REQUIRE_EQUAL( aActual.OutlineCount(), aExpected.OutlineCount() );
+
+    for( int i = 0; i < aExpected.OutlineCount(); i++ )
+    {
+        BOOST_REQUIRE_EQUAL( aActual.HoleCount( i ), aExpected.HoleCount( i ) );
+
+        for( int j = -1; j < aExpected.HoleCount( i ); j++ )
+        {
+            const SHAPE_LINE_CHAIN& expected = j < 0 ? aExpected.COutline( i )
+                                                     : aExpected.CHole( i, j );
+            const SHAPE_LINE_CHAIN& actual = j < 0 ? aActual.COutline( i )
+                                                   : aActual.CHole( i, j );
+
+            BOOST_REQUIRE_EQUAL( actual.PointCount(), expected.PointCount() );
+
+            for( int k = 0; k < expected.PointCount(); k++ )
+                BOOST_CHECK( actual.CPoint( k ) == expected.CPoint( k ) );
+        }
+    }
+}
+
+
+/**
+ * Checks that the parallel union gives exactly the outlines of the serial one, for sets
+ * with and without gaps along Y.  The sets with gaps are cut into several bands, which
+ * are simplified on worker threads.
+ */
+BOOST_AUTO_TEST_CASE( MatchesSimplify )
+{
+    // 200 rows are closer than the size of the disks, which then leave no gap
+    const struct
+    {
+        int  m_rows;
+        bool m_hasGaps;
+    } cases[] = { { 0, false }, { 10, true }, { 40, true }, { 200, false } };
+
+    for( const auto& c : cases )
+    {
+        SHAPE_POLY_SET serial = randomDisks( 3000, 70000000, c.m_rows, c.m_rows + 1 );
+        SHAPE_POLY_SET parallel = serial;
+
+        serial.Simplify( SHAPE_POLY_SET::PM_FAST );
+        int bands = parallel.SimplifyParallel( SHAPE_POLY_SET::PM_FAST );
+
+        if( c.m_hasGaps )
+            BOOST_CHECK_GT( bands, 1 );
+        else
+            BOOST_CHECK_EQUAL( bands, 1 );
+
+        checkIdentical( serial, parallel );
+    }
+}
+
+
+/**
+ * Checks that a large set of empty outlines is handled.
+ */
+BOOST_AUTO_TEST_CASE( EmptyOutlines )
+{
+    SHAPE_POLY_SET set;
+
+    for( int i = 0; i < 2000; i++ )
+        set.NewOutline();
+
+    set.SimplifyParallel( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( set.OutlineCount(), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( SegBatch )
+
+/**
+ * Checks that the SIMD scan finds the same segments as the scalar one, for small
+ * coordinates and for coordinates spanning the whole integer range.
+ */
+BOOST_AUTO_TEST_CASE( MatchesScalar )
+{
+    std::mt19937 rng( 1 );
+    std::uniform_int_distribution<int> wide( -2000000000, 2000000000 );
+    std::uniform_int_distribution<int> narrow( -1000, 1000 );
+
+    for( int test = 0; test < 2000; test++ )
+    {
+        std::uniform_int_distribution<int>& coord = ( test % 2 ) ? narrow : wide;
+        int segmentCount = 1 + test % 37;
+        std::vector<VECTOR2I> points( segmentCount + 1 );
+
+        for( VECTOR2I& p : points )
+            p = VECTOR2I( coord( rng ), coord( rng ) );
+
+        BOX2I box( VECTOR2I( coord( rng ), coord( rng ) ),
+                   VECTOR2I( coord( rng ) / 4, coord( rng ) / 4 ) );
+        int clearance = std::abs( coord( rng ) ) / 8;
+
+        for( int start = 0; start <= segmentCount; start++ )
+        {
+            BOOST_CHECK_EQUAL( FindSegmentNearBox( &points[0], start, segmentCount, box, clearance ),
+                    FindSegmentNearBoxScalar( &points[0], start, segmentCount, box, clearance ) );
+        }
+    }
+}
+
+/**
+ * Checks that the scan never skips a segment colliding with a segment in the box.
+ */
+BOOST_AUTO_TEST_CASE( NeverSkipsCollisions )
+{
+    std::mt19937 rng( 2 );
+    std::uniform_int_distribution<int> coord( -10000, 10000 );
+
+    for( int test = 0; test < 2000; test++ )
+    {
+        SHAPE_LINE_CHAIN chain;
+
+        for( int i = 0; i < 10; i++ )
+            chain.Append( VECTOR2I( coord( rng ), coord( rng ) ) );
+
+        chain.SetClosed( test % 2 );
+
+        SEG seg( VECTOR2I( coord( rng ), coord( rng ) ), VECTOR2I( coord( rng ), coord( rng ) ) );
+        BOX2I box( seg.A, seg.B - seg.A );
+        int clearance = std::abs( coord( rng ) ) / 10;
+
+        std::vector<bool> near( chain.SegmentCount(), false );
+
+        for( int i = chain.NextSegmentNear( box, clearance ); i >= 0;
+             i = chain.NextSegmentNear( box, clearance, i + 1 ) )
+            near[i] = true;
+
+        for( int i = 0; i < chain.SegmentCount(); i++ )
+        {
+            if( chain.CSegment( i ).Collide( seg, clearance ) )
+                BOOST_CHECK( near[i] );
+        }
+    }
+}
+
+/**
+ * Checks that SHAPE_LINE_CHAIN::Collide( SEG ) gives the results of the per-segment loop it
+ * replaced, including a zero clearance, which never reported a collision.
+ */
+BOOST_AUTO_TEST_CASE( CollideMatchesPerSegment )
+{
+    std::mt19937 rng( 3 );
+    std::uniform_int_distribution<int> coord( -10000, 10000 );
+
+    for( int test = 0; test < 2000; test++ )
+    {
+        SHAPE_LINE_CHAIN chain;
+
+        for( int i = 0; i < 10; i++ )
+            chain.Append( VECTOR2I( coord( rng ), coord( rng ) ) );
+
+        chain.SetClosed( test % 2 );
+
+        SEG seg( VECTOR2I( coord( rng ), coord( rng ) ), VECTOR2I( coord( rng ), coord( rng ) ) );
+        int clearance = ( test % 3 ) ? std::abs( coord( rng ) ) / 10 : 0;
+
+        BOX2I box_a( seg.A, seg.B - seg.A );
+        BOX2I::ecoord_type dist_sq = (BOX2I::ecoord_type) clearance * clearance;
+        bool expected = false;
+
+        for( int i = 0; i < chain.SegmentCount() && !expected; i++ )
+        {
+            const SEG& s = chain.CSegment( i );
+            BOX2I box_b( s.A, s.B - s.A );
+
+            expected = box_a.SquaredDistance( box_b ) < dist_sq && s.Collide( seg, clearance );
+        }
+
+        BOOST_CHECK_EQUAL( chain.Collide( seg, clearance ), expected );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
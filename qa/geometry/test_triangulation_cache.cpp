@@ -0,0 +1,193 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+#include <set>
+
+BOOST_AUTO_TEST_SUITE( TriangulationCache )
+
+typedef SHAPE_POLY_SET::TRIANGULATED_POLYGON TRIANGULATED_POLYGON;
+
+/**
+ * Builds aColumns * aRows disjoint disks of aPoints vertices each, on a grid.
+ */
+static SHAPE_POLY_SET gridDisks( int aColumns, int aRows, int aPoints )
+{
+    const int pitch = 3000000;
+    const int radius = 1000000;
+    SHAPE_POLY_SET set;
+
+    for( int row = 0; row < aRows; row++ )
+    {
+        for( int column = 0; column < aColumns; column++ )
+        {
+            set.NewOutline();
+
+            for( int k = 0; k < aPoints; k++ )
+            {
+                double angle = k * 2 * M_PI / aPoints;
+
+                set.Append( column * pitch + int( radius * cos( angle ) ),
+                            row * pitch + int( radius * sin( angle ) ) );
+            }
+        }
+    }
+
+    return set;
+}
+
+
+/**
+ * Moves the first vertex of the outline of aSet closest to aWhere towards its centre.
+ */
+static void dentOutline( SHAPE_POLY_SET& aSet, const VECTOR2I& aWhere )
+{
+    int closest = 0;
+
+    for( int i = 1; i < aSet.OutlineCount(); i++ )
+    {
+        if( ( aSet.COutline( i ).CPoint( 0 ) - aWhere ).EuclideanNorm()
+                < ( aSet.COutline( closest ).CPoint( 0 ) - aWhere ).EuclideanNorm() )
+            closest = i;
+    }
+
+    aSet.Outline( closest ).Point( 0 ) -= VECTOR2I( 300000, 0 );
+}
+
+
+/**
+ * @return the triangulations of aSet, by address.
+ */
+static std::set<const TRIANGULATED_POLYGON*> triangulations( const SHAPE_POLY_SET& aSet )
+{
+    std::set<const TRIANGULATED_POLYGON*> polys;
+
+    for( unsigned i = 0; i < aSet.TriangulatedPolyCount(); i++ )
+        polys.insert( aSet.TriangulatedPolygon( i ) );
+
+    return polys;
+}
+
+
+/**
+ * Checks that aSet holds exactly the triangles of a fresh serial triangulation of its
+ * outlines.
+ */
+static void checkMatchesSerial( const SHAPE_POLY_SET& aSet )
+{
+    SHAPE_POLY_SET fresh;
+
+    for( int i = 0; i < aSet.OutlineCount(); i++ )
+        fresh.AddOutline( aSet.COutline( i ) );
+
+    fresh.CacheTriangulation( false );
+
+    BOOST_REQUIRE( aSet.IsTriangulationUpToDate() );
+    BOOST_REQUIRE_EQUAL( aSet.TriangulatedPolyCount(), fresh.TriangulatedPolyCount() );
+
+    for( unsigned i = 0; i < fresh.TriangulatedPolyCount(); i++ )
+    {
+        const TRIANGULATED_POLYGON* expected = fresh.TriangulatedPolygon( i );
+        const TRIANGULATED_POLYGON* actual = aSet.TriangulatedPolygon( i );
+
+        BOOST_REQUIRE_EQUAL( actual->GetTriangleCount(), expected->GetTriangleCount() );
+
+        for( int j = 0; j < expected->GetTriangleCount(); j++ )
+        {
+            VECTOR2I ea, eb, ec, aa, ab, ac;
+
+            expected->GetTriangle( j, ea, eb, ec );
+            actual->GetTriangle( j, aa, ab, ac );
+
+            BOOST_CHECK( aa == ea && ab == eb && ac == ec );
+        }
+    }
+}
+
+
+/**
+ * Changes a single outline: only that outline is triangulated again, the others keep
+ * their triangles.
+ */
+BOOST_AUTO_TEST_CASE( ReusesUnchangedOutlines )
+{
+    SHAPE_POLY_SET set = gridDisks( 5, 4, 64 );
+
+    set.CacheTriangulation();
+    checkMatchesSerial( set );
+
+    std::set<const TRIANGULATED_POLYGON*> before = triangulations( set );
+
+    dentOutline( set, VECTOR2I( 2 * 3000000, 3000000 ) );
+    set.CacheTriangulation();
+
+    std::set<const TRIANGULATED_POLYGON*> after = triangulations( set );
+    std::set<const TRIANGULATED_POLYGON*> reused;
+
+    for( const TRIANGULATED_POLYGON* poly : after )
+    {
+        if( before.count( poly ) )
+            reused.insert( poly );
+    }
+
+    BOOST_CHECK_EQUAL( after.size(), 20 );
+    BOOST_CHECK_EQUAL( reused.size(), 19 );
+    checkMatchesSerial( set );
+}
+
+
+/**
+ * Changes two large outlines, which together have enough vertices to be triangulated on
+ * several threads.
+ */
+BOOST_AUTO_TEST_CASE( ParallelRetriangulation )
+{
+    // CacheTriangulation() goes parallel from 5000 vertices to triangulate, over more
+    // than one outline.  The disks keep about 3000 vertices each once simplified, so both
+    // calls below take that branch.
+    SHAPE_POLY_SET set = gridDisks( 2, 2, 4000 );
+
+    set.CacheTriangulation();
+    checkMatchesSerial( set );
+
+    std::set<const TRIANGULATED_POLYGON*> before = triangulations( set );
+
+    dentOutline( set, VECTOR2I( 0, 0 ) );
+    dentOutline( set, VECTOR2I( 3000000, 3000000 ) );
+    set.CacheTriangulation();
+
+    std::set<const TRIANGULATED_POLYGON*> after = triangulations( set );
+    int reused = 0;
+
+    for( const TRIANGULATED_POLYGON* poly : after )
+        reused += before.count( poly );
+
+    BOOST_CHECK_EQUAL( after.size(), 4 );
+    BOOST_CHECK_EQUAL( reused, 2 );
+    checkMatchesSerial( set );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,245 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pns_replay.cpp
+ * @brief Replays a router session recorded with KICAD_PNS_RECORD, without the board
+ * editor, and prints the latency of each kind of router call.
+ *
+ * usage: pns_replay <name> [repeat count]
+ * where <name>.kicad_pcb and <name>.events are the files written by the router tool.
+ */
+
+#include <io_mgr.h>
+#include <kicad_plugin.h>
+
+#include <class_board.h>
+#include <profile.h>
+
+#include <router/pns_kicad_iface.h>
+#include <router/pns_logger.h>
+#include <router/pns_router.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+
+BOARD* loadBoard( const std::string& filename )
+{
+    PLUGIN::RELEASER pi( new PCB_IO );
+    BOARD* brd = nullptr;
+
+    try
+    {
+        brd = pi->Load( wxString( filename.c_str() ), NULL, NULL );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxString msg = wxString::Format( _( "Error loading board.\n%s" ),
+                ioe.Problem() );
+
+        printf( "%s\n", (const char*) msg.mb_str() );
+        return nullptr;
+    }
+
+    return brd;
+}
+
+
+/**
+ * Finds the item a recorded event refers to, among the items under the event position.
+ */
+PNS::ITEM* findItem( PNS::ROUTER& aRouter, const PNS::LOGGER::EVENT_ENTRY& aEvent )
+{
+    if( !aEvent.itemKind )
+        return nullptr;
+
+    auto candidates = aRouter.QueryHoverItems( aEvent.p );
+
+    for( PNS::ITEM* item : candidates.Items() )
+    {
+        if( item->Kind() == aEvent.itemKind && item->Net() == aEvent.itemNet
+                && item->Layers().Start() == aEvent.itemLayerStart
+                && item->Layers().End() == aEvent.itemLayerEnd )
+            return item;
+    }
+
+    return nullptr;
+}
+
+
+void setupRouter( PNS::ROUTER& aRouter, const PNS::LOGGER::EVENT_ENTRY& aEvent )
+{
+    aRouter.SetMode( (PNS::ROUTER_MODE) aEvent.routerMode );
+    aRouter.Settings().SetMode( (PNS::PNS_MODE) aEvent.routingMode );
+
+    PNS::SIZES_SETTINGS sizes = aRouter.Sizes();
+    sizes.SetTrackWidth( aEvent.trackWidth );
+    sizes.SetViaDiameter( aEvent.viaDiameter );
+    sizes.SetViaDrill( aEvent.viaDrill );
+    aRouter.UpdateSizes( sizes );
+}
+
+
+void replay( PNS::ROUTER& aRouter, const std::vector<PNS::LOGGER::EVENT_ENTRY>& aEvents,
+             std::vector<std::vector<double>>& aLatencies )
+{
+    for( const auto& evt : aEvents )
+    {
+        PNS::ITEM* item = findItem( aRouter, evt );
+
+        // Only the router call is measured, not the lookup of the item
+        PROF_COUNTER timer;
+
+        switch( evt.type )
+        {
+        case PNS::LOGGER::EVT_START_ROUTE:
+            setupRouter( aRouter, evt );
+            aRouter.StartRouting( evt.p, item, evt.arg );
+            break;
+
+        case PNS::LOGGER::EVT_START_DRAG:
+            setupRouter( aRouter, evt );
+            aRouter.StartDragging( evt.p, item, evt.arg );
+            break;
+
+        case PNS::LOGGER::EVT_MOVE:
+            aRouter.Move( evt.p, item );
+            break;
+
+        case PNS::LOGGER::EVT_FIX:
+            aRouter.FixRoute( evt.p, item, evt.arg );
+            break;
+
+        case PNS::LOGGER::EVT_STOP:
+            aRouter.StopRouting();
+            break;
+        }
+
+        aLatencies[evt.type].push_back( timer.msecs() );
+    }
+
+    aRouter.StopRouting();
+}
+
+
+void printLatencies( const char* aName, std::vector<double>& aSamples )
+{
+    if( aSamples.empty() )
+        return;
+
+    std::sort( aSamples.begin(), aSamples.end() );
+
+    double total = 0.0;
+
+    for( double t : aSamples )
+        total += t;
+
+    auto percentile = [&aSamples]( double p )
+    {
+        return aSamples[ std::min( aSamples.size() - 1, size_t( p * aSamples.size() ) ) ];
+    };
+
+    printf( "%s: %d calls, %.1f ms total, mean %.3f ms, p50 %.3f ms, p90 %.3f ms, "
+            "p99 %.3f ms, max %.3f ms\n", aName, (int) aSamples.size(), total,
+            total / aSamples.size(), percentile( 0.5 ), percentile( 0.9 ),
+            percentile( 0.99 ), aSamples.back() );
+
+    // 1-2-5 buckets, from 0.1 ms to 1 s
+    const double bounds[] = { 0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+    const int    bucketCount = sizeof( bounds ) / sizeof( bounds[0] ) + 1;
+    int          counts[bucketCount] = { 0 };
+
+    for( double t : aSamples )
+    {
+        int i = std::upper_bound( bounds, bounds + bucketCount - 1, t ) - bounds;
+        counts[i]++;
+    }
+
+    for( int i = 0; i < bucketCount; i++ )
+    {
+        if( !counts[i] )
+            continue;
+
+        int bar = ( 50 * counts[i] + aSamples.size() - 1 ) / aSamples.size();
+
+        if( i < bucketCount - 1 )
+            printf( "    < %6.1f ms %8d %s\n", bounds[i], counts[i], std::string( bar, '#' ).c_str() );
+        else
+            printf( "   >= %6.1f ms %8d %s\n", bounds[i - 1], counts[i], std::string( bar, '#' ).c_str() );
+    }
+}
+
+
+int main( int argc, char *argv[] )
+{
+    if( argc < 2 )
+    {
+        printf( "usage: %s <recorded session name> [repeat count]\n", argv[0] );
+        return -1;
+    }
+
+    std::string name = argv[1];
+    int repeat = argc > 2 ? std::max( 1, atoi( argv[2] ) ) : 1;
+
+    std::vector<PNS::LOGGER::EVENT_ENTRY> events;
+
+    if( !PNS::LOGGER::LoadEvents( name + ".events", events ) )
+    {
+        printf( "Cannot read %s.events\n", name.c_str() );
+        return -1;
+    }
+
+    std::unique_ptr<BOARD> board( loadBoard( name + ".kicad_pcb" ) );
+
+    if( !board )
+        return -1;
+
+    // No host tool and no view: the routed tracks stay in the router world
+    PNS_KICAD_IFACE iface;
+    PNS::ROUTER     router;
+
+    iface.SetBoard( board.get() );
+    iface.SetView( nullptr );
+    router.SetInterface( &iface );
+
+    std::vector<std::vector<double>> latencies( PNS::LOGGER::EVT_STOP + 1 );
+
+    PROF_COUNTER total;
+
+    for( int i = 0; i < repeat; i++ )
+    {
+        router.SyncWorld();
+        replay( router, events, latencies );
+    }
+
+    printf( "%d events, %d runs, %.1f ms\n", (int) events.size(), repeat, total.msecs() );
+
+    const char* names[] = { "StartRouting", "StartDragging", "Move", "FixRoute", "StopRouting" };
+
+    for( int i = 0; i <= PNS::LOGGER::EVT_STOP; i++ )
+        printLatencies( names[i], latencies[i] );
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file seg_batch_benchmark.cpp
+ * @brief Compares the scalar and SIMD segment scans, and the line chain / segment
+ * collision test with the per-segment loop it replaced.
+ *
+ * usage: seg_batch_benchmark [chain vertex count] [query count]
+ */
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+#include <profile.h>
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+/**
+ * The collision test SHAPE_LINE_CHAIN used before, verbatim: a bounding box distance
+ * check, then the exact test, one segment at a time.
+ */
+static bool collidePerSegment( const SHAPE_LINE_CHAIN& aChain, const SEG& aSeg, int aClearance )
+{
+    BOX2I box_a( aSeg.A, aSeg.B - aSeg.A );
+    BOX2I::ecoord_type dist_sq = (BOX2I::ecoord_type) aClearance * aClearance;
+
+    for( int i = 0; i < aChain.SegmentCount(); i++ )
+    {
+        const SEG& s = aChain.CSegment( i );
+        BOX2I box_b( s.A, s.B - s.A );
+
+        BOX2I::ecoord_type d = box_a.SquaredDistance( box_b );
+
+        if( d < dist_sq )
+        {
+            if( s.Collide( aSeg, aClearance ) )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+int main( int argc, char *argv[] )
+{
+    int vertexCount = argc > 1 ? std::max( 2, atoi( argv[1] ) ) : 1000;
+    int queryCount = argc > 2 ? std::max( 1, atoi( argv[2] ) ) : 20000;
+
+    std::mt19937 rng( 1 );
+    std::uniform_int_distribution<int> step( -500000, 500000 );
+    std::uniform_int_distribution<int> position( -50000000, 50000000 );
+
+    // a meandering track, 0.5 mm steps
+    SHAPE_LINE_CHAIN chain;
+    VECTOR2I p( 0, 0 );
+
+    for( int i = 0; i < vertexCount; i++ )
+    {
+        chain.Append( p );
+        p += VECTOR2I( step( rng ), step( rng ) );
+    }
+
+    std::vector<SEG> queries;
+
+    for( int i = 0; i < queryCount; i++ )
+    {
+        VECTOR2I a( position( rng ), position( rng ) );
+        queries.push_back( SEG( a, a + VECTOR2I( step( rng ), step( rng ) ) ) );
+    }
+
+    const int clearance = 200000;
+    const VECTOR2I* points = &chain.CPoint( 0 );
+    int segmentCount = chain.PointCount() - 1;
+
+    printf( "%d segments, %d queries\n", segmentCount, queryCount );
+
+    long candidates[2] = { 0, 0 };
+    double times[2];
+
+    for( int simd = 0; simd < 2; simd++ )
+    {
+        auto find = simd ? FindSegmentNearBox : FindSegmentNearBoxScalar;
+        PROF_COUNTER timer;
+
+        for( const SEG& q : queries )
+        {
+            BOX2I box( q.A, q.B - q.A );
+
+            for( int i = find( points, 0, segmentCount, box, clearance ); i >= 0;
+                 i = find( points, i + 1, segmentCount, box, clearance ) )
+                candidates[simd]++;
+        }
+
+        times[simd] = timer.msecs();
+    }
+
+    printf( "scan, scalar:      %8.2f ms, %ld candidates\n", times[0], candidates[0] );
+    printf( "scan, simd:        %8.2f ms, %ld candidates (%.2fx)\n", times[1], candidates[1],
+            times[0] / times[1] );
+
+    int hits[2] = { 0, 0 };
+
+    for( int batched = 0; batched < 2; batched++ )
+    {
+        PROF_COUNTER timer;
+
+        for( const SEG& q : queries )
+        {
+            if( batched ? chain.Collide( q, clearance ) : collidePerSegment( chain, q, clearance ) )
+                hits[batched]++;
+        }
+
+        times[batched] = timer.msecs();
+    }
+
+    printf( "collide, per segment: %8.2f ms, %d hits\n", times[0], hits[0] );
+    printf( "collide, batched:     %8.2f ms, %d hits (%.2fx)\n", times[1], hits[1],
+            times[0] / times[1] );
+
+    return ( candidates[0] == candidates[1] && hits[0] == hits[1] ) ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+import unittest
+import pcbnew
+
+from pcbnew import *
+
+
+class TestZoneRefill(unittest.TestCase):
+    """Refilling the zones around a change gives the copper of a complete fill"""
+
+    def setUp(self):
+        self.pcb = LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.zone = self.pcb.GetArea(0)
+
+        # The raw fill is not saved in board files: fill once, as the editor does
+        ZONE_FILLER(self.pcb).Fill(self.pcb.Zones())
+
+    def filledPolys(self):
+        return SHAPE_POLY_SET(self.zone.GetFilledPolysList())
+
+    def copperDiffers(self, aPolysA, aPolysB):
+        for a, b in ((aPolysA, aPolysB), (aPolysB, aPolysA)):
+            diff = SHAPE_POLY_SET(a)
+            diff.BooleanSubtract(b, SHAPE_POLY_SET.PM_FAST)
+
+            # The edges of the refilled window leave slivers of a few nm, where the
+            # intersections are rounded: only look for differences wider than 2 um
+            diff.Inflate(-FromMM(0.001), 16)
+
+            if not diff.IsEmpty():
+                return True
+
+        return False
+
+    def moveAndRefill(self, aItem):
+        before = self.filledPolys()
+
+        area = aItem.GetBoundingBox()
+        aItem.Move(wxPointMM(1.5, 0.5))
+        area.Merge(aItem.GetBoundingBox())
+        self.pcb.BuildConnectivity()
+
+        filler = ZONE_FILLER(self.pcb)
+        filler.SetRefillArea(area)
+        filler.Fill(self.pcb.Zones())
+        partial = self.filledPolys()
+
+        ZONE_FILLER(self.pcb).Fill(self.pcb.Zones())
+        full = self.filledPolys()
+
+        self.assertTrue(self.copperDiffers(before, full))
+        self.assertFalse(self.copperDiffers(partial, full))
+
+    def test_move_track(self):
+        zoneBox = self.zone.GetBoundingBox()
+        tracks = [track for track in self.pcb.GetTracks()
+                  if track.GetLayer() == self.zone.GetLayer()
+                  and track.GetNetCode() != self.zone.GetNetCode()
+                  and zoneBox.Contains(track.GetBoundingBox())]
+
+        self.assertTrue(tracks)
+        self.moveAndRefill(tracks[0])
+
+    def test_move_footprint(self):
+        # The pads connected to the zone get thermal reliefs, rebuilt around the change
+        netCode = self.zone.GetNetCode()
+        layer = self.zone.GetLayer()
+        modules = [module for module in self.pcb.GetModules()
+                   if any(pad.GetNetCode() == netCode and pad.IsOnLayer(layer)
+                          for pad in module.Pads())]
+
+        self.assertTrue(modules)
+        self.moveAndRefill(modules[0])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,71 @@
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+import pcbnew
+
+from pcbnew import *
+
+
+DRC_SCRIPT = os.path.join("..", "demos", "python_scripts_examples", "drc_board.py")
+
+
+class TestBatchDrc(unittest.TestCase):
+    """Runs the DRC without the board editor, on a board with two crossing tracks"""
+
+    def setUp(self):
+        self.outputDir = tempfile.mkdtemp()
+        self.filename = os.path.join(self.outputDir, "crossing.kicad_pcb")
+
+        pcb = BOARD()
+        self.addTrack(pcb, "A", wxPointMM(0, 0), wxPointMM(10, 0))
+        self.addTrack(pcb, "B", wxPointMM(5, -5), wxPointMM(5, 5))
+        SaveBoard(self.filename, pcb)
+
+    def tearDown(self):
+        shutil.rmtree(self.outputDir)
+
+    def addTrack(self, aBoard, aNetName, aStart, aEnd):
+        net = NETINFO_ITEM(aBoard, aNetName)
+        aBoard.Add(net)
+
+        track = TRACK(aBoard)
+        track.SetStart(aStart)
+        track.SetEnd(aEnd)
+        track.SetWidth(FromMM(0.25))
+        track.SetLayer(F_Cu)
+        track.SetNet(net)
+        aBoard.Add(track)
+
+    def test_batch_tests(self):
+        pcb = LoadBoard(self.filename)
+
+        drc = DRC(pcb, MILLIMETRES)
+        drc.SetSettings(True, True, True, True, False, True, "", False)
+        drc.RunBatchTests()
+
+        self.assertEqual(pcb.GetMARKERCount(), 1)
+        self.assertEqual(drc.GetUnconnectedCount(), 0)
+        self.assertTrue(drc.GetPassCount() > 0)
+
+    def test_drc_board_script(self):
+        # The exit code of the script is the number of errors
+        status = subprocess.call([sys.executable, DRC_SCRIPT, self.filename, self.outputDir])
+        self.assertEqual(status, 1)
+
+        with open(os.path.join(self.outputDir, "crossing-drc.json")) as jsonFile:
+            report = json.load(jsonFile)
+
+        self.assertEqual(len(report["errors"]), 1)
+        self.assertEqual(len(report["unconnected"]), 0)
+        self.assertTrue("item_b" in report["errors"][0])
+
+        with open(os.path.join(self.outputDir, "crossing-drc.csv")) as csvFile:
+            # the header, and one line for the error
+            self.assertEqual(len(csvFile.readlines()), 2)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,75 @@
+import os
+import shutil
+import tempfile
+import unittest
+import pcbnew
+
+from pcbnew import *
+
+
+class TestIncrementalDrc(unittest.TestCase):
+    """Tests again only the items close to a change, and keeps the other markers"""
+
+    TRACK_COUNT = 40
+
+    def setUp(self):
+        self.outputDir = tempfile.mkdtemp()
+        filename = os.path.join(self.outputDir, "tracks.kicad_pcb")
+
+        # Parallel tracks 2 mm apart, and far from them two crossing tracks
+        pcb = BOARD()
+
+        for i in range(self.TRACK_COUNT):
+            self.addTrack(pcb, "N%d" % i, wxPointMM(0, 2 * i), wxPointMM(10, 2 * i))
+
+        self.addTrack(pcb, "X", wxPointMM(100, 0), wxPointMM(110, 0))
+        self.addTrack(pcb, "Y", wxPointMM(105, -5), wxPointMM(105, 5))
+        SaveBoard(filename, pcb)
+
+        self.pcb = LoadBoard(filename)
+        self.drc = DRC(self.pcb, MILLIMETRES)
+        self.drc.SetSettings(True, True, True, True, False, True, "", False)
+        self.drc.RunBatchTests()
+
+        self.assertEqual(self.pcb.GetMARKERCount(), 1)
+
+    def tearDown(self):
+        shutil.rmtree(self.outputDir)
+
+    def addTrack(self, aBoard, aNetName, aStart, aEnd):
+        net = NETINFO_ITEM(aBoard, aNetName)
+        aBoard.Add(net)
+
+        track = TRACK(aBoard)
+        track.SetStart(aStart)
+        track.SetEnd(aEnd)
+        track.SetWidth(FromMM(0.25))
+        track.SetLayer(F_Cu)
+        track.SetNet(net)
+        aBoard.Add(track)
+
+    def moveAndTest(self, aTrack, aOffset):
+        area = aTrack.GetBoundingBox()
+        aTrack.Move(aOffset)
+        area.Merge(aTrack.GetBoundingBox())
+        self.pcb.BuildConnectivity()
+
+        self.drc.RunIncrementalTests(area)
+
+    def test_move_track(self):
+        track = [t for t in self.pcb.GetTracks() if t.GetNetname() == "N20"][0]
+
+        # 0.2 mm away from the track of N21: they overlap
+        self.moveAndTest(track, wxPointMM(0, 1.8))
+
+        # Only the moved track and the one of N21 are tested again
+        self.assertEqual(self.drc.GetIncrementalTestCount(), 2)
+        self.assertEqual(self.pcb.GetMARKERCount(), 2)
+
+        self.moveAndTest(track, wxPointMM(0, -1.8))
+
+        self.assertEqual(self.drc.GetIncrementalTestCount(), 2)
+        self.assertEqual(self.pcb.GetMARKERCount(), 1)
+
+if __name__ == '__main__':
+    unittest.main()